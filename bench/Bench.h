@@ -0,0 +1,109 @@
+// Wspólne narzędzia mikrobenchmarków: pomiar czasu i instancje testowe.
+#pragma once
+
+#include "Config.h"
+#include "VRP.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Instancja użyta w benchmarku wraz z nazwą do raportu.
+struct BenchInstance {
+    std::string name;
+    Problem problem;
+};
+
+// Zwraca instancje z katalogu inputs/ oraz syntetyczne instancje o podanych rozmiarach.
+std::vector<BenchInstance> loadBenchInstances(const std::vector<int>& syntheticSizes);
+
+// Buduje losową instancję z `customers` klientami (współrzędne 0..1000, stałe ziarno).
+Problem makeSyntheticProblem(int customers, unsigned seed);
+
+// Zwraca konfigurację z domyślnymi parametrami algorytmów (jak ConfigLoader bez pliku), seed=1.
+Config makeBenchConfig();
+
+// Zwraca `count` losowych permutacji klientów dla danej instancji (stałe ziarno).
+std::vector<std::vector<int>> makeBenchPermutations(const Problem& problem, int count, unsigned seed);
+
+// Ustawienia pomiarów statystycznych (z linii poleceń vrp_bench).
+struct BenchOptions {
+    int repetitions = 15;        // liczba próbek na pomiar
+    double warmupMs = 20.0;      // minimalny czas rozgrzewki przed próbkami
+    double minSampleUs = 50.0;   // próbka obejmuje tyle wywołań, by trwała co najmniej tyle
+    double maxSeconds = 3.0;     // limit czasu próbek jednego pomiaru (nie mniej niż 5 próbek)
+    std::string jsonPath;        // plik raportu JSON (pusty - bez raportu)
+};
+BenchOptions& benchOptions();
+
+// Statystyki czasu jednego wywołania (ns) z próbek pomiaru.
+struct BenchStats {
+    double medianNs = 0.0;
+    double madNs = 0.0;          // mediana odchyleń bezwzględnych od mediany
+    double minNs = 0.0;
+    int samples = 0;
+    long long batch = 1;         // wywołań w jednej próbce
+};
+
+// Liczy medianę, MAD i minimum z próbek (ns na wywołanie).
+BenchStats summarizeSamples(std::vector<double> samples, long long batch);
+
+// Mierzy fn: rozgrzewka, w trakcie której dobierana jest liczba wywołań na próbkę (próbka trwa co
+// najmniej minSampleUs), potem benchOptions().repetitions próbek.
+template <typename Fn>
+BenchStats measureStats(Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+    const BenchOptions& options = benchOptions();
+    auto timeBatch = [&](long long batch) {
+        auto start = Clock::now();
+        for (long long b = 0; b < batch; ++b) fn();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+    long long batch = 1;
+    const auto warmupEnd = Clock::now() + std::chrono::duration<double, std::milli>(options.warmupMs);
+    double sampleNs = timeBatch(batch);
+    while (sampleNs < options.minSampleUs * 1e3 || Clock::now() < warmupEnd) {
+        if (sampleNs < options.minSampleUs * 1e3) batch *= 2;
+        sampleNs = timeBatch(batch);
+    }
+    int repetitions = options.repetitions;
+    int affordable = static_cast<int>(options.maxSeconds * 1e9 / sampleNs);
+    repetitions = std::max(std::min(repetitions, affordable), std::min(repetitions, 5));
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    for (int r = 0; r < repetitions; ++r) samples.push_back(timeBatch(batch) / static_cast<double>(batch));
+    return summarizeSamples(std::move(samples), batch);
+}
+
+// Wypisuje wiersz wyniku i dodaje go do raportu JSON.
+void reportBench(const std::string& suite, const std::string& kernel, const std::string& instance, int n,
+                 const BenchStats& stats);
+// Zapisuje zebrane wyniki reportBench do pliku JSON; false gdy pliku nie da się otworzyć.
+bool writeBenchJson(const std::string& path);
+
+// Zapisuje instancję w formacie VRPLIB (EUC_2D), np. do pomiaru parsera na instancjach syntetycznych.
+void writeVrpFile(const Problem& problem, const std::string& path);
+
+// Zapobiega wyrzuceniu obliczeń przez optymalizator.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Poszczególne zestawy benchmarków.
+void benchDistanceLayout();
+void benchSaStep();
+void benchDecode();
+void benchDecoders();
+void benchRng();
+void benchEaScaling();
+void benchCandidates();
+void benchLocalSearch();
+void benchCrossover();
+void benchKernels();
+void benchParser();
+void benchDistanceOracle();
+void benchBatchEval();
+void benchEaDispatch();
@@ -0,0 +1,166 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+Problem makeSyntheticProblem(int customers, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_int_distribution<int> demand(1, 30);
+    Problem problem{};
+    problem.dimension = customers + 1;
+    problem.capacity = 100;
+    problem.depotId = 1;
+    problem.demands.assign(problem.dimension + 1, 0);
+    problem.xs.assign(problem.dimension + 1, 0.0);
+    problem.ys.assign(problem.dimension + 1, 0.0);
+    for (int id = 1; id <= problem.dimension; ++id) {
+        double x = id == problem.depotId ? 500.0 : std::round(coord(gen));
+        double y = id == problem.depotId ? 500.0 : std::round(coord(gen));
+        int dem = id == problem.depotId ? 0 : demand(gen);
+        problem.nodes.push_back(Node{id, x, y, dem});
+        problem.demands[id] = dem;
+        problem.xs[id] = x;
+        problem.ys[id] = y;
+    }
+    buildDistanceMatrix(problem);
+    buildCandidateLists(problem, kDefaultCandidates);
+    return problem;
+}
+
+std::vector<BenchInstance> loadBenchInstances(const std::vector<int>& syntheticSizes) {
+    std::vector<BenchInstance> result;
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory("inputs")) {
+        for (const auto& entry : std::filesystem::directory_iterator("inputs")) {
+            if (entry.path().extension() == ".vrp") files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& path : files) {
+        try {
+            result.push_back(BenchInstance{path.stem().string(), parseVRP(path.string())});
+        } catch (const std::exception& ex) {
+            std::cerr << "Pominięto " << path << ": " << ex.what() << "\n";
+        }
+    }
+    for (int size : syntheticSizes) {
+        result.push_back(BenchInstance{"synthetic-n" + std::to_string(size), makeSyntheticProblem(size, 12345u + size)});
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> makeBenchPermutations(const Problem& problem, int count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<int> base;
+    for (const auto& node : problem.nodes) {
+        if (node.id != problem.depotId) base.push_back(node.id);
+    }
+    std::vector<std::vector<int>> perms(count, base);
+    for (auto& perm : perms) std::shuffle(perm.begin(), perm.end(), gen);
+    return perms;
+}
+
+Config makeBenchConfig() {
+    Config cfg{};
+    cfg.randomIterations = 1000;
+    cfg.greedyRestarts = 32;
+    cfg.saInitialTemp = 100.0;
+    cfg.saMinTemp = 0.01;
+    cfg.saCoolingRate = 0.995;
+    cfg.saIterations = 200;
+    cfg.eaPopulation = 100;
+    cfg.eaGenerations = 100;
+    cfg.eaCrossoverRate = 0.7;
+    cfg.eaMutationRate = 0.1;
+    cfg.eaTournament = 5;
+    cfg.eaElites = 1;
+    cfg.eaCrossoverType = "pmx";
+    cfg.eaMutationType = "inversion";
+    cfg.eaThreads = 1;
+    cfg.decoder = "greedy";
+    cfg.seed = 1;
+    cfg.threads = 1;
+    return cfg;
+}
+
+BenchOptions& benchOptions() {
+    static BenchOptions options;
+    return options;
+}
+
+static double median(std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2 == 1) return upper;
+    return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + mid));
+}
+
+BenchStats summarizeSamples(std::vector<double> samples, long long batch) {
+    BenchStats stats;
+    stats.samples = static_cast<int>(samples.size());
+    stats.batch = batch;
+    if (samples.empty()) return stats;
+    stats.minNs = *std::min_element(samples.begin(), samples.end());
+    stats.medianNs = median(samples);
+    for (double& value : samples) value = std::fabs(value - stats.medianNs);
+    stats.madNs = median(samples);
+    return stats;
+}
+
+namespace {
+struct BenchRecord {
+    std::string suite, kernel, instance;
+    int n;
+    BenchStats stats;
+};
+std::vector<BenchRecord>& benchRecords() {
+    static std::vector<BenchRecord> records;
+    return records;
+}
+}  // namespace
+
+void reportBench(const std::string& suite, const std::string& kernel, const std::string& instance, int n,
+                 const BenchStats& stats) {
+    std::printf("%-16s %-18s %7d %14.1f %12.1f %14.1f %6d\n", kernel.c_str(), instance.c_str(), n, stats.medianNs,
+                stats.madNs, stats.minNs, stats.samples);
+    std::fflush(stdout);
+    benchRecords().push_back(BenchRecord{suite, kernel, instance, n, stats});
+}
+
+bool writeBenchJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    const BenchOptions& options = benchOptions();
+    out << "{\n  \"repetitions\": " << options.repetitions << ",\n  \"warmup_ms\": " << options.warmupMs
+        << ",\n  \"min_sample_us\": " << options.minSampleUs << ",\n  \"results\": [";
+    const auto& records = benchRecords();
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchRecord& r = records[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"suite\": \"" << r.suite << "\", \"kernel\": \"" << r.kernel
+            << "\", \"instance\": \"" << r.instance << "\", \"n\": " << r.n
+            << ", \"median_ns\": " << r.stats.medianNs << ", \"mad_ns\": " << r.stats.madNs
+            << ", \"min_ns\": " << r.stats.minNs << ", \"samples\": " << r.stats.samples
+            << ", \"batch\": " << r.stats.batch << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+void writeVrpFile(const Problem& problem, const std::string& path) {
+    std::ofstream out(path);
+    out << "NAME : synthetic\nTYPE : CVRP\nDIMENSION : " << problem.dimension
+        << "\nEDGE_WEIGHT_TYPE : EUC_2D\nCAPACITY : " << problem.capacity << "\nNODE_COORD_SECTION\n";
+    for (const auto& node : problem.nodes) out << " " << node.id << " " << node.x << " " << node.y << "\n";
+    out << "DEMAND_SECTION\n";
+    for (const auto& node : problem.nodes) out << node.id << " " << node.demand << "\n";
+    out << "DEPOT_SECTION\n " << problem.depotId << "\n -1\nEOF\n";
+}
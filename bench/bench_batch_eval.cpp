@@ -0,0 +1,66 @@
+// Ocena wsadowa dekoderem greedy (evaluateBatch) na poziomach SIMD dostępnych na procesorze vs
+// decodeCost wywoływany dla każdej permutacji. Wynik: czas bloku kBatch permutacji i oceny na sekundę.
+// Przed pomiarem każdy poziom jest sprawdzany z greedyCost dla bloków niepełnych i pełnych.
+#include "BatchEval.h"
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const char* kSuite = "batch_eval";
+static const int kBatch = 64;
+
+static void reportRate(const char* kernel, const BenchInstance& inst, const BenchStats& stats) {
+    reportBench(kSuite, kernel, inst.name, inst.problem.dimension, stats);
+    std::printf("%-16s %-18s %7s %11.3g eval/s\n", "", "", "", kBatch / (stats.medianNs * 1e-9));
+}
+
+// Sprawdza, czy evaluateBatch na poziomie level daje dla pierwszych count permutacji te same koszty co
+// greedyCost (obietnica BatchEval.h); liczby count nie będące wielokrotnością 8/16 obejmują niepełny
+// ostatni blok linii. Przy niezgodności przerywa program.
+static void checkBatch(const Problem& problem, const std::vector<int>& flat, const std::vector<int>& offsets,
+                       int genes, SimdLevel level) {
+    std::vector<double> costs(offsets.size());
+    for (int count : {1, 7, 9, 15, 17, 31, kBatch}) {
+        evaluateBatch(problem, flat.data(), offsets.data(), count, genes, costs.data(), level);
+        for (int b = 0; b < count; ++b) {
+            double expected = greedyCost(problem, flat.data() + offsets[b], genes);
+            if (costs[b] == expected) continue;
+            std::fprintf(stderr, "batch_%s: koszt linii %d z %d to %.17g, greedyCost %.17g\n", simdLevelName(level),
+                         b, count, costs[b], expected);
+            std::abort();
+        }
+    }
+}
+
+void benchBatchEval() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : loadBenchInstances({200, 1000})) {
+        const Problem& problem = inst.problem;
+        const int genes = problem.dimension - 1;
+        auto perms = makeBenchPermutations(problem, kBatch, 5u);
+        std::vector<int> flat;
+        std::vector<int> offsets;
+        for (const auto& perm : perms) {
+            offsets.push_back(static_cast<int>(flat.size()));
+            flat.insert(flat.end(), perm.begin(), perm.end());
+        }
+        std::vector<double> costs(kBatch);
+        reportRate("decode_cost", inst, measureStats([&] {
+            for (int b = 0; b < kBatch; ++b) costs[b] = decodeCost(problem, perms[b]);
+            doNotOptimize(costs[kBatch - 1]);
+        }));
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (batchSimdLevel(problem, level) != level) continue;
+            checkBatch(problem, flat, offsets, genes, level);
+            std::string kernel = std::string("batch_") + simdLevelName(level);
+            reportRate(kernel.c_str(), inst, measureStats([&] {
+                evaluateBatch(problem, flat.data(), offsets.data(), kBatch, genes, costs.data(), level);
+                doNotOptimize(costs[kBatch - 1]);
+            }));
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// Listy kandydatów: czas budowy (siatka) i konstrukcja zachłanna z listami vs pełne przeglądanie
+// (czas jednej pełnej konstrukcji).
+#include "Algorithms.h"
+#include "Bench.h"
+#include "Logger.h"
+
+#include <cstdio>
+#include <limits>
+#include <unordered_set>
+
+static const char* kSuite = "candidates";
+
+// Dawna konstrukcja najbliższego sąsiada: przegląd wszystkich nieodwiedzonych w unordered_set.
+static std::vector<int> scanGreedyPermutation(const Problem& problem, int startId) {
+    std::unordered_set<int> unvisited;
+    for (const auto& node : problem.nodes) {
+        if (node.id != problem.depotId) unvisited.insert(node.id);
+    }
+    std::vector<int> order;
+    int current = startId;
+    while (!unvisited.empty()) {
+        order.push_back(current);
+        unvisited.erase(current);
+        if (unvisited.empty()) break;
+        double bestDist = std::numeric_limits<double>::infinity();
+        int bestNext = *unvisited.begin();
+        for (int candidate : unvisited) {
+            double dist = problem.distances(current, candidate);
+            if (dist < bestDist) {
+                bestDist = dist;
+                bestNext = candidate;
+            }
+        }
+        current = bestNext;
+    }
+    return order;
+}
+
+void benchCandidates() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (auto& inst : loadBenchInstances({1000, 3000, 10000})) {
+        Problem& problem = inst.problem;
+        const int n = problem.dimension;
+        reportBench(kSuite, "build_lists", inst.name, n,
+                    measureStats([&] { buildCandidateLists(problem, kDefaultCandidates); }));
+        BenchStats scan = measureStats([&] { doNotOptimize(scanGreedyPermutation(problem, 2).size()); });
+        reportBench(kSuite, "scan_greedy", inst.name, n, scan);
+        Config cfg = makeBenchConfig();
+        cfg.greedyRestarts = 1;
+        CSVLogger logger;
+        BenchStats knn = measureStats([&] {
+            Budget budget;
+            doNotOptimize(runGreedy(problem, cfg, logger, budget).cost);
+        });
+        reportBench(kSuite, "knn_greedy", inst.name, n, knn);
+        std::printf("%-16s %-18s %7s %10.1fx speedup\n", "", "", "", scan.medianNs / knn.medianNs);
+    }
+}
@@ -0,0 +1,96 @@
+// Krzyżowania: czas jednego wywołania (mediana z measureStats) i czas na gen dla rosnącego n. Wersje
+// legacy_* to poprzednie implementacje O(n^2) (wyszukiwanie liniowe, nowy wektor co wywołanie).
+#include "Bench.h"
+#include "Operators.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+static std::vector<int> legacyOrdered(const std::vector<int>& p1, const std::vector<int>& p2) {
+    int n = static_cast<int>(p1.size());
+    std::vector<int> child(n, -1);
+    int a = randInt(0, n - 1);
+    int b = randInt(0, n - 1);
+    if (a > b) std::swap(a, b);
+    for (int i = a; i <= b; ++i) child[i] = p1[i];
+    int idx = (b + 1) % n;
+    for (int i = 0; i < n; ++i) {
+        int candidate = p2[(b + 1 + i) % n];
+        bool used = false;
+        for (int val : child) if (val == candidate) { used = true; break; }
+        if (used) continue;
+        while (child[idx] != -1) idx = (idx + 1) % n;
+        child[idx] = candidate;
+    }
+    return child;
+}
+
+static std::vector<int> legacyCycle(const std::vector<int>& p1, const std::vector<int>& p2) {
+    int n = static_cast<int>(p1.size());
+    std::vector<int> child(n, -1);
+    std::vector<bool> visited(n, false);
+    bool takeFromP1 = true;
+    int start = 0;
+    while (std::find(visited.begin(), visited.end(), false) != visited.end()) {
+        while (start < n && visited[start]) ++start;
+        int idx = start;
+        do {
+            visited[idx] = true;
+            child[idx] = takeFromP1 ? p1[idx] : p2[idx];
+            idx = static_cast<int>(std::find(p2.begin(), p2.end(), p1[idx]) - p2.begin());
+        } while (idx != start);
+        takeFromP1 = !takeFromP1;
+    }
+    return child;
+}
+
+static const char* kSuite = "crossover";
+
+// Wiersz wyniku (mediana, MAD, minimum - także w raporcie JSON) i czas mediany na gen.
+static void reportPerGene(const std::string& kernel, const std::string& instance, int n, const BenchStats& stats) {
+    reportBench(kSuite, kernel, instance, n, stats);
+    std::printf("%-16s %-18s %7s %11.1f ns/gen\n", "", "", "", stats.medianNs / n);
+}
+
+void benchCrossover() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (int n : {50, 100, 200, 1000, 3000, 10000}) {
+        Problem problem = makeSyntheticProblem(n, 5u);
+        auto perms = makeBenchPermutations(problem, 2, 17u);
+        const std::vector<int>& p1 = perms[0];
+        const std::vector<int>& p2 = perms[1];
+        CrossoverWorkspace ws(problem.dimension + 1);
+        std::vector<int> child;
+        ScopedRngStream stream(7);
+        const std::string instance = "synthetic-n" + std::to_string(n);
+        const int genes = static_cast<int>(p1.size());
+
+        struct Row {
+            const char* name;
+            CrossoverType type;
+            std::function<std::vector<int>()> legacy;
+        };
+        const Row rows[] = {
+            {"ox", CrossoverType::Ordered, [&] { return legacyOrdered(p1, p2); }},
+            {"pmx", CrossoverType::PartiallyMapped, nullptr},
+            {"cx", CrossoverType::Cycle, [&] { return legacyCycle(p1, p2); }},
+            {"erx", CrossoverType::EdgeRecombination, nullptr},
+            {"eax", CrossoverType::EdgeAssembly, nullptr},
+        };
+        for (const Row& row : rows) {
+            if (row.legacy) {
+                reportPerGene(std::string("legacy_") + row.name, instance, genes,
+                              measureStats([&] { doNotOptimize(row.legacy().data()); }));
+            }
+            reportPerGene(row.name, instance, genes, measureStats([&] {
+                crossover(row.type, problem, p1.data(), p2.data(), n, child, ws);
+                doNotOptimize(child.data());
+            }));
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// Porównanie pełnego dekodowania (Solution z trasami) z jednoprzebiegowym decodeCost. Jedno wywołanie
+// pomiaru dekoduje kolejną permutację z puli, więc czasy są na jedną permutację.
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdio>
+
+static const char* kSuite = "decode";
+
+void benchDecode() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : loadBenchInstances({1000, 3000})) {
+        const Problem& problem = inst.problem;
+        auto perms = makeBenchPermutations(problem, problem.dimension > 1000 ? 32 : 256, 3u);
+        std::size_t next = 0;
+        auto nextPerm = [&]() -> const std::vector<int>& {
+            const std::vector<int>& perm = perms[next];
+            next = next + 1 == perms.size() ? 0 : next + 1;
+            return perm;
+        };
+        BenchStats full = measureStats([&] { doNotOptimize(decodePermutation(problem, nextPerm()).cost); });
+        reportBench(kSuite, "decode_permutation", inst.name, problem.dimension, full);
+        BenchStats fused = measureStats([&] { doNotOptimize(decodeCost(problem, nextPerm())); });
+        reportBench(kSuite, "decode_cost", inst.name, problem.dimension, fused);
+        std::printf("%-16s %-18s %7s %10.1fx speedup\n", "", "", "", full.medianNs / fused.medianNs);
+    }
+}
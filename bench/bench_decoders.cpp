@@ -0,0 +1,86 @@
+// Dekoder zachłanny vs Split: czas dekodowania jednej permutacji i jakość EA przy równym czasie.
+#include "Algorithms.h"
+#include "Bench.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+static const char* kSuite = "decoders";
+
+// Wiersz czasu dekodowania (kolejna permutacja z puli na wywołanie) i ewaluacje na sekundę.
+static void reportDecoder(const char* label, const BenchInstance& inst, const std::vector<std::vector<int>>& perms,
+                          DecoderType decoder) {
+    std::size_t next = 0;
+    BenchStats stats = measureStats([&] {
+        doNotOptimize(decodeCost(inst.problem, perms[next], decoder));
+        next = next + 1 == perms.size() ? 0 : next + 1;
+    });
+    reportBench(kSuite, std::string("decode_") + label, inst.name, inst.problem.dimension, stats);
+    std::printf("%-16s %-18s %7s %11.3g eval/s\n", "", "", "", 1e9 / stats.medianNs);
+}
+
+static Config eaBenchConfig(const std::string& decoder, bool fleetLimit, int generations) {
+    Config cfg = makeBenchConfig();
+    cfg.eaGenerations = generations;
+    cfg.eaCrossoverRate = 0.8;
+    cfg.eaMutationRate = 0.2;
+    cfg.eaTournament = 3;
+    cfg.eaElites = 2;
+    cfg.eaCrossoverType = "pmx";
+    cfg.eaMutationType = "inversion";
+    cfg.decoder = decoder;
+    cfg.splitFleetLimit = fleetLimit;
+    return cfg;
+}
+
+static double secondsOf(const Problem& problem, const Config& cfg, double& cost) {
+    CSVLogger logger("/dev/null", kEaLogHeader);
+    Budget budget;
+    auto start = std::chrono::steady_clock::now();
+    cost = runEvolutionary(problem, cfg, logger, budget).cost;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void benchDecoders() {
+    struct Variant {
+        const char* label;
+        const char* decoder;
+        bool fleetLimit;
+    };
+    const Variant variants[] = {{"greedy", "greedy", false}, {"split", "split", false}, {"split-k", "split", true}};
+    const int baseGenerations = 300;
+
+    const auto instances = loadBenchInstances({1000});
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : instances) {
+        auto perms = makeBenchPermutations(inst.problem, inst.problem.dimension > 500 ? 64 : 512, 5u);
+        for (const auto& v : variants) reportDecoder(v.label, inst, perms, parseDecoderType(v.decoder, v.fleetLimit));
+    }
+
+    // Dla dużych instancji tylko czas dekodera (EA z PMX jest tu za wolne).
+    std::printf("\n%-18s %-8s %8s %10s %8s\n", "instance", "decoder", "gens", "ea_cost", "gap%");
+    for (const auto& inst : instances) {
+        const Problem& problem = inst.problem;
+        if (problem.dimension > 500) continue;
+        double optimal = readOptimalCost((std::filesystem::path("optimal-solutions") / (inst.name + ".sol")).string());
+        double budget = 0.0;
+        for (const auto& v : variants) {
+            // Liczba pokoleń dobrana tak, aby czas EA był równy czasowi wariantu zachłannego.
+            int generations = baseGenerations;
+            double cost = 0.0;
+            if (budget == 0.0) {
+                budget = secondsOf(problem, eaBenchConfig(v.decoder, v.fleetLimit, generations), cost);
+            } else {
+                double probe = secondsOf(problem, eaBenchConfig(v.decoder, v.fleetLimit, 30), cost);
+                generations = std::max(1, static_cast<int>(budget / (probe / 30.0)));
+                secondsOf(problem, eaBenchConfig(v.decoder, v.fleetLimit, generations), cost);
+            }
+            double gap = optimal > 0 ? 100.0 * (cost - optimal) / optimal : 0.0;
+            std::printf("%-18s %-8s %8d %10.0f %8.2f\n", inst.name.c_str(), v.label, generations, cost, gap);
+        }
+    }
+}
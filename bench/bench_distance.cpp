@@ -0,0 +1,135 @@
+// Porównanie układów macierzy odległości w pętli dekodowania permutacji. Jedno wywołanie pomiaru
+// dekoduje kolejną permutację z puli, więc czasy są na jedną ewaluację.
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdio>
+
+// Dekodowanie zachłanne na dowolnej macierzy (lookup) i tablicy zapotrzebowań.
+template <typename Lookup, typename Demand>
+static double decodeLoop(const std::vector<int>& perm, int capacity, int depot, Lookup dist, Demand demandOf) {
+    double total = 0.0;
+    int load = 0;
+    int prev = depot;
+    for (int customer : perm) {
+        int demand = demandOf(customer);
+        if (load + demand > capacity) {
+            total += dist(prev, depot);
+            prev = depot;
+            load = 0;
+        }
+        total += dist(prev, customer);
+        load += demand;
+        prev = customer;
+    }
+    return total + dist(prev, depot);
+}
+
+template <typename T>
+static FlatDistanceMatrix<T> convertMatrix(const Problem& problem) {
+    FlatDistanceMatrix<T> matrix;
+    matrix.resize(problem.dimension + 1);
+    for (int i = 1; i <= problem.dimension; ++i) {
+        for (int j = 1; j <= problem.dimension; ++j) matrix.set(i, j, problem.distances(i, j));
+    }
+    return matrix;
+}
+
+template <typename Lookup, typename Demand>
+static void reportLayout(const char* kernel, const BenchInstance& inst, const std::vector<std::vector<int>>& perms,
+                         Lookup dist, Demand demandOf) {
+    const Problem& problem = inst.problem;
+    std::size_t next = 0;
+    reportBench("distance_layout", kernel, inst.name, problem.dimension, measureStats([&] {
+        doNotOptimize(decodeLoop(perms[next], problem.capacity, problem.depotId, dist, demandOf));
+        next = next + 1 == perms.size() ? 0 : next + 1;
+    }));
+}
+
+template <typename T>
+static void reportFlat(const char* kernel, const BenchInstance& inst, const std::vector<std::vector<int>>& perms) {
+    FlatDistanceMatrix<T> matrix = convertMatrix<T>(inst.problem);
+    const int* demands = inst.problem.demands.data();
+    reportLayout(kernel, inst, perms, [&](int a, int b) { return static_cast<double>(matrix(a, b)); },
+                 [demands](int id) { return demands[id]; });
+}
+
+void benchDistanceLayout() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : loadBenchInstances({1000, 3000})) {
+        const Problem& problem = inst.problem;
+        auto perms = makeBenchPermutations(problem, problem.dimension > 1000 ? 32 : 256, 7u);
+
+        std::vector<std::vector<double>> nested(problem.dimension + 1, std::vector<double>(problem.dimension + 1, 0.0));
+        for (int i = 1; i <= problem.dimension; ++i) {
+            for (int j = 1; j <= problem.dimension; ++j) nested[i][j] = problem.distances(i, j);
+        }
+        reportLayout("nested_aos", inst, perms, [&](int a, int b) { return nested[a][b]; },
+                     [&](int id) { return problem.nodes[id - 1].demand; });
+        reportFlat<double>("flat_double", inst, perms);
+        reportFlat<float>("flat_float", inst, perms);
+        reportFlat<int32_t>("flat_i32", inst, perms);
+        reportFlat<uint16_t>("flat_u16", inst, perms);
+    }
+}
+
+// Tryb odległości na żądanie (DistanceOracle) vs gęsta macierz: budowa, pojedyncze odległości,
+// wiersz (jądro SIMD), zbieranie listy kandydatów, długość trasy i dekodowanie permutacji.
+void benchDistanceOracle() {
+    const char* kSuite = "distance_oracle";
+    std::printf("jądro SIMD: %s\n", distanceKernelName());
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (int customers : {1000, 5000}) {
+        Problem dense = makeSyntheticProblem(customers, 11u);
+        Problem onDemand = dense;
+        buildDistanceMatrix(dense, DistanceSettings{DistanceMode::Dense});
+        buildDistanceMatrix(onDemand, DistanceSettings{DistanceMode::OnDemand});
+        const int n = dense.dimension;
+        const std::string name = "synthetic-n" + std::to_string(customers);
+        const Problem* problems[] = {&dense, &onDemand};
+        const char* suffix[] = {"dense", "on_demand"};
+        auto perms = makeBenchPermutations(dense, 4, 3u);
+        const std::vector<int>& perm = perms[0];
+        std::vector<double> out(perm.size());
+
+        for (int m = 0; m < 2; ++m) {
+            Problem rebuilt = *problems[m];
+            DistanceSettings settings{m == 0 ? DistanceMode::Dense : DistanceMode::OnDemand};
+            reportBench(kSuite, std::string("build_") + suffix[m], name, n, measureStats([&] {
+                buildDistanceMatrix(rebuilt, settings);
+                doNotOptimize(rebuilt.distances.size());
+            }));
+        }
+        for (int m = 0; m < 2; ++m) {
+            const DistanceOracle& distances = problems[m]->distances;
+            int row = 1;
+            reportBench(kSuite, std::string("pairs_") + suffix[m], name, n, measureStats([&] {
+                double sum = 0.0;
+                for (int j = 1; j <= n; ++j) sum += distances(row, j);
+                row = row % n + 1;
+                doNotOptimize(sum);
+            }));
+            // Kolejne wiersze trafiają w różne sloty pamięci podręcznej, więc każdy jest liczony od nowa.
+            reportBench(kSuite, std::string("row_") + suffix[m], name, n, measureStats([&] {
+                const DistanceValue* values = distances.row(row);
+                double sum = 0.0;
+                for (int j = 1; j <= n; ++j) sum += values[j];
+                row = row % n + 1;
+                doNotOptimize(sum);
+            }));
+            reportBench(kSuite, std::string("gather16_") + suffix[m], name, n, measureStats([&] {
+                distances.gather(row, problems[m]->candidates.of(row), problems[m]->candidates.k(), out.data());
+                row = row % n + 1;
+                doNotOptimize(out[0]);
+            }));
+            reportBench(kSuite, std::string("route_") + suffix[m], name, n, measureStats([&] {
+                doNotOptimize(distances.routeLength(problems[m]->depotId, perm.data(), static_cast<int>(perm.size())));
+            }));
+            reportBench(kSuite, std::string("split_") + suffix[m], name, n, measureStats([&] {
+                doNotOptimize(decodeCost(*problems[m], perm, DecoderType::Split));
+            }));
+        }
+    }
+}
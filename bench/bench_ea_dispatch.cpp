@@ -0,0 +1,103 @@
+// Pętla potomstwa EA (selekcja, krzyżowanie, mutacja, dekodowanie greedy) dla OX/PMX/CX x swap/inversion:
+// dawny wybór operatorów na każde dziecko (przełączanie po CrossoverType, porównanie nazwy mutacji,
+// decodeCost z DecoderType) vs pętla skonkretyzowana politykami z EaPolicies.h, jak w EvolutionRun.
+#include "Bench.h"
+#include "EaPolicies.h"
+#include "Random.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static const char* kSuite = "ea_dispatch";
+
+// Rodzice, następne pokolenie i bufory jednego pomiaru.
+struct DispatchSetup {
+    const Problem& problem;
+    const Population& parents;
+    Population& next;
+    CrossoverWorkspace& ws;
+    std::vector<int>& child;
+};
+
+static const int kTournament = 5;
+static const double kCrossoverRate = 0.9;
+static const double kMutationRate = 0.2;
+
+// Dawna pętla: rodzaj operatorów rozpoznawany przy każdym dziecku.
+static void legacyGeneration(DispatchSetup& s, CrossoverType type, const std::string& mutationType) {
+    const int genes = s.parents.genes();
+    for (int slot = 0; slot < s.parents.size(); ++slot) {
+        int p1 = tournamentSelect(s.parents, kTournament);
+        int p2 = tournamentSelect(s.parents, kTournament);
+        std::uint64_t hash;
+        if (randUnit() < kCrossoverRate) {
+            crossover(type, s.problem, s.parents.row(p1), s.parents.row(p2), genes, s.child, s.ws);
+            hash = permutationHash(s.child.data(), genes);
+        } else {
+            s.child.assign(s.parents.row(p1), s.parents.row(p1) + genes);
+            hash = s.parents.hash(p1);
+        }
+        if (mutationType == "inversion" || mutationType == "inv") mutateInversion(s.child, hash, kMutationRate);
+        else mutateSwap(s.child, hash, kMutationRate);
+        s.next.assign(slot, s.child.data(), decodeCost(s.problem, s.child, DecoderType::Greedy), hash);
+    }
+}
+
+// Pętla z politykami wybranymi raz (jak EvolutionRun::breedRange).
+template <typename Crossover, typename Mutation>
+static void policyGeneration(DispatchSetup& s) {
+    const int genes = s.parents.genes();
+    for (int slot = 0; slot < s.parents.size(); ++slot) {
+        int p1 = tournamentSelect(s.parents, kTournament);
+        int p2 = tournamentSelect(s.parents, kTournament);
+        std::uint64_t hash;
+        if (randUnit() < kCrossoverRate) {
+            Crossover::apply(s.problem, s.parents.row(p1), s.parents.row(p2), genes, s.child, s.ws);
+            hash = permutationHash(s.child.data(), genes);
+        } else {
+            s.child.assign(s.parents.row(p1), s.parents.row(p1) + genes);
+            hash = s.parents.hash(p1);
+        }
+        Mutation::apply(s.child, hash, kMutationRate);
+        s.next.assign(slot, s.child.data(), GreedyDecoding::cost(s.problem, s.child, DecoderType::Greedy), hash);
+    }
+}
+
+void benchEaDispatch() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    const int populationSize = 100;
+    for (int n : {50, 200, 1000}) {
+        Problem problem = makeSyntheticProblem(n, 9u);
+        const std::string name = "synthetic-n" + std::to_string(n);
+        const int genes = problem.dimension - 1;
+        Population parents(populationSize, genes);
+        Population next(populationSize, genes);
+        auto perms = makeBenchPermutations(problem, populationSize, 21u);
+        for (int i = 0; i < populationSize; ++i) {
+            parents.assign(i, perms[i].data(), decodeCost(problem, perms[i]), permutationHash(perms[i].data(), genes));
+        }
+        CrossoverWorkspace ws(problem.dimension + 1);
+        std::vector<int> child;
+        DispatchSetup setup{problem, parents, next, ws, child};
+        ScopedRngStream stream(13);
+
+        auto run = [&](const std::string& label, CrossoverType type, MutationType mutation, const char* mutationName) {
+            reportBench(kSuite, "legacy_" + label, name, problem.dimension,
+                        measureStats([&] { legacyGeneration(setup, type, mutationName); }));
+            // Polityki wybierane raz, jak w konstruktorze EvolutionRun.
+            auto generation = dispatchEaPolicies(type, mutation, false, DecoderType::Greedy,
+                                                 [](auto crossover, auto mutationPolicy, auto, auto) {
+                                                     return &policyGeneration<decltype(crossover), decltype(mutationPolicy)>;
+                                                 });
+            reportBench(kSuite, "policy_" + label, name, problem.dimension, measureStats([&] { generation(setup); }));
+        };
+        for (auto [crossoverName, type] : {std::pair<const char*, CrossoverType>{"ox", CrossoverType::Ordered},
+                                           {"pmx", CrossoverType::PartiallyMapped},
+                                           {"cx", CrossoverType::Cycle}}) {
+            run(std::string(crossoverName) + "_swap", type, MutationType::Swap, "swap");
+            run(std::string(crossoverName) + "_inv", type, MutationType::Inversion, "inversion");
+        }
+    }
+}
@@ -0,0 +1,36 @@
+// Skalowanie równoległego generowania potomstwa EA względem liczby wątków i rozmiaru populacji.
+#include "Algorithms.h"
+#include "Bench.h"
+#include "Random.h"
+
+#include <chrono>
+#include <cstdio>
+
+void benchEaScaling() {
+    Problem problem = parseVRP("inputs/A-n60-k9.vrp");
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    const int populations[] = {100, 1000, 10000};
+    std::printf("%-8s %8s %14s %10s\n", "pop", "threads", "ms/generation", "speedup");
+    for (int population : populations) {
+        double baseline = 0.0;
+        for (int threads : threadCounts) {
+            Config cfg = makeBenchConfig();
+            cfg.eaPopulation = population;
+            cfg.eaGenerations = population >= 10000 ? 3 : 20;
+            cfg.eaThreads = threads;  // 1 = tryb sekwencyjny (punkt odniesienia)
+            CSVLogger logger("/dev/null", kEaLogHeader);
+            double ms = 1e300;
+            for (int rep = 0; rep < 3; ++rep) {
+                ScopedRngStream stream(7);
+                Budget budget;
+                auto start = std::chrono::steady_clock::now();
+                runEvolutionary(problem, cfg, logger, budget);
+                double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed < ms) ms = elapsed;
+            }
+            ms /= cfg.eaGenerations;
+            if (threads == 1) baseline = ms;
+            std::printf("%-8d %8d %14.3f %9.2fx\n", population, threads, ms, baseline / ms);
+        }
+    }
+}
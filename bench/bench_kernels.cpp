@@ -0,0 +1,127 @@
+// Jądra obliczeniowe z pełną statystyką (rozgrzewka, powtórzenia, mediana i MAD, raport JSON):
+// parser, macierz odległości, dekodowanie, ocena, operatory EA, krok SA i pokolenie EA.
+#include "Algorithms.h"
+#include "Bench.h"
+#include "FitnessCache.h"
+#include "Operators.h"
+#include "Population.h"
+#include "Random.h"
+#include "SwapDelta.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const char* kSuite = "kernels";
+
+// Pokolenie EA: różnica czasu runów z 1 + kGenerations i 1 pokoleniem (ta sama inicjalizacja).
+static BenchStats measureEaGeneration(const Problem& problem) {
+    const int kGenerations = 10;
+    Config cfg = makeBenchConfig();
+    CSVLogger logger;
+    auto runSeconds = [&](int generations) {
+        cfg.eaGenerations = generations;
+        ScopedRngStream stream(21);
+        Budget budget;
+        auto start = std::chrono::steady_clock::now();
+        doNotOptimize(runEvolutionary(problem, cfg, logger, budget).cost);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    };
+    runSeconds(1);  // rozgrzewka
+    std::vector<double> samples;
+    double spent = 0.0;
+    const BenchOptions& options = benchOptions();
+    for (int r = 0; r < options.repetitions && (r < 5 || spent < options.maxSeconds * 1e9); ++r) {
+        double longer = runSeconds(1 + kGenerations);
+        double shorter = runSeconds(1);
+        spent += longer + shorter;
+        samples.push_back(std::max(0.0, longer - shorter) / kGenerations);
+    }
+    return summarizeSamples(std::move(samples), 1);
+}
+
+static void benchInstance(const std::string& name, const std::string& path, const Problem& problem) {
+    const int n = problem.dimension;
+    auto report = [&](const char* kernel, const BenchStats& stats) { reportBench(kSuite, kernel, name, n, stats); };
+    ScopedRngStream stream(5);
+
+    report("parse", measureStats([&] { doNotOptimize(parseVRP(path).dimension); }));
+    Problem rebuilt = problem;
+    report("distance_matrix", measureStats([&] {
+        buildDistanceMatrix(rebuilt);
+        doNotOptimize(rebuilt.distances(1, n));
+    }));
+
+    auto perms = makeBenchPermutations(problem, 2, 17u);
+    const std::vector<int>& p1 = perms[0];
+    const std::vector<int>& p2 = perms[1];
+    const int genes = static_cast<int>(p1.size());
+    report("decode", measureStats([&] { doNotOptimize(decodePermutation(problem, p1).cost); }));
+    Solution decoded = decodePermutation(problem, p1);
+    report("evaluate", measureStats([&] { doNotOptimize(evaluateSolution(problem, decoded)); }));
+
+    CrossoverWorkspace workspace(problem.dimension + 1);
+    std::vector<int> child;
+    const std::pair<const char*, CrossoverType> crossovers[] = {
+        {"crossover_ox", CrossoverType::Ordered},
+        {"crossover_pmx", CrossoverType::PartiallyMapped},
+        {"crossover_cx", CrossoverType::Cycle},
+        {"crossover_erx", CrossoverType::EdgeRecombination},
+        {"crossover_eax", CrossoverType::EdgeAssembly},
+    };
+    for (const auto& entry : crossovers) {
+        report(entry.first, measureStats([&] {
+            crossover(entry.second, problem, p1.data(), p2.data(), genes, child, workspace);
+            doNotOptimize(child.data());
+        }));
+    }
+
+    std::vector<int> perm = p1;
+    std::uint64_t hash = permutationHash(perm.data(), genes);
+    report("mutate_swap", measureStats([&] { doNotOptimize(mutateSwap(perm, hash, 1.0)); }));
+    report("mutate_inversion", measureStats([&] { doNotOptimize(mutateInversion(perm, hash, 1.0)); }));
+    report("two_opt_once", measureStats([&] { doNotOptimize(twoOptOnce(perm, hash, problem)); }));
+
+    Population population(100, genes);
+    for (int i = 0; i < population.size(); ++i) population.assign(i, p1.data(), randUnit() * 1000.0, 0);
+    report("tournament", measureStats([&] { doNotOptimize(tournamentSelect(population, 5)); }));
+
+    // Krok SA jak w runSimulatedAnnealing: zamiana oceniona przyrostowo i kryterium Metropolisa.
+    SwapDeltaEvaluator state(problem, p1);
+    double currentCost = state.cost();
+    report("sa_step", measureStats([&] {
+        int i = randInt(0, genes - 1);
+        int j = randInt(0, genes - 1);
+        while (j == i) j = randInt(0, genes - 1);
+        double cost = state.applySwap(i, j);
+        double delta = cost - currentCost;
+        if (delta < 0 || randUnit() < std::exp(-delta / 20.0)) {
+            state.commit();
+            currentCost = cost;
+        } else {
+            state.undo();
+        }
+    }));
+
+    report("ea_generation", measureEaGeneration(problem));
+}
+
+void benchKernels() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : loadBenchInstances({1000, 10000})) {
+        std::string path = (std::filesystem::path("inputs") / (inst.name + ".vrp")).string();
+        bool synthetic = !std::filesystem::exists(path);
+        if (synthetic) {
+            path = (std::filesystem::temp_directory_path() / ("vrp_bench_" + inst.name + ".vrp")).string();
+            writeVrpFile(inst.problem, path);
+        }
+        benchInstance(inst.name, path, inst.problem);
+        if (synthetic) std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,79 @@
+// Przeszukiwanie lokalne na trasach: czas do optimum lokalnego oraz jakość EA przy równym czasie
+// (jedna losowa próba 2-opt na permutacji vs edukacja dzieci przez LocalSearch).
+#include "Algorithms.h"
+#include "Bench.h"
+#include "LocalSearch.h"
+#include "Logger.h"
+#include "Random.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+static Config lsBenchConfig(const char* localSearch, int generations) {
+    Config cfg = makeBenchConfig();
+    cfg.eaPopulation = 50;
+    cfg.eaGenerations = generations;
+    cfg.eaCrossoverType = "ox";
+    cfg.eaTwoOptRate = 0.2;
+    cfg.eaLocalSearch = localSearch;
+    cfg.decoder = "split";
+    return cfg;
+}
+
+static double eaSeconds(const Problem& problem, const Config& cfg, double& cost) {
+    CSVLogger logger;
+    ScopedRngStream stream(11);
+    Budget budget;
+    auto start = std::chrono::steady_clock::now();
+    cost = runEvolutionary(problem, cfg, logger, budget).cost;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void benchLocalSearch() {
+    std::printf("%-18s %8s %12s %12s %12s %12s\n", "instance", "n", "random", "first[ms]", "first_cost",
+                "best_cost");
+    for (const auto& inst : loadBenchInstances({1000, 3000})) {
+        const Problem& problem = inst.problem;
+        auto perms = makeBenchPermutations(problem, 4, 9u);
+        LocalSearch search(problem);
+        double initial = 0.0, first = 0.0, best = 0.0, ms = 0.0;
+        ScopedRngStream stream(3);
+        for (const auto& perm : perms) {
+            Solution start = decodePermutation(problem, perm);
+            initial += start.cost;
+            Solution s = start;
+            auto t0 = std::chrono::steady_clock::now();
+            search.improve(s, LsStrategy::FirstImprovement);
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            first += s.cost;
+            if (problem.dimension <= 1000) {
+                s = start;
+                search.improve(s, LsStrategy::BestImprovement);
+                best += s.cost;
+            }
+        }
+        double count = static_cast<double>(perms.size());
+        std::string bestText = problem.dimension <= 1000 ? std::to_string(static_cast<long long>(best / count)) : "-";
+        std::printf("%-18s %8d %12.0f %12.2f %12.0f %12s\n", inst.name.c_str(), problem.dimension, initial / count,
+                    ms / count, first / count, bestText.c_str());
+    }
+
+    // EA przy równym czasie: liczba pokoleń wariantu routes dobrana do czasu wariantu two_opt.
+    std::printf("\n%-18s %-8s %8s %10s %8s\n", "instance", "ls", "gens", "ea_cost", "gap%");
+    for (const auto& inst : loadBenchInstances({})) {
+        const Problem& problem = inst.problem;
+        double optimal = readOptimalCost((std::filesystem::path("optimal-solutions") / (inst.name + ".sol")).string());
+        double cost = 0.0;
+        const int baseGenerations = 400;
+        double budget = eaSeconds(problem, lsBenchConfig("two_opt", baseGenerations), cost);
+        std::printf("%-18s %-8s %8d %10.0f %8.2f\n", inst.name.c_str(), "two_opt", baseGenerations, cost,
+                    optimal > 0 ? 100.0 * (cost - optimal) / optimal : 0.0);
+        double probe = eaSeconds(problem, lsBenchConfig("routes", 20), cost);
+        int generations = std::max(1, static_cast<int>(budget / (probe / 20.0)));
+        eaSeconds(problem, lsBenchConfig("routes", generations), cost);
+        std::printf("%-18s %-8s %8d %10.0f %8.2f\n", inst.name.c_str(), "routes", generations, cost,
+                    optimal > 0 ? 100.0 * (cost - optimal) / optimal : 0.0);
+    }
+}
@@ -0,0 +1,51 @@
+// Program uruchamiający mikrobenchmarki.
+// Użycie: vrp_bench [fragment nazwy zestawu] [--reps N] [--json plik]
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::string filter;
+    BenchOptions& options = benchOptions();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--reps" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else {
+            filter = arg;
+        }
+    }
+    const std::vector<std::pair<std::string, void (*)()>> suites = {
+        {"distance_layout", benchDistanceLayout},
+        {"sa_step", benchSaStep},
+        {"decode", benchDecode},
+        {"decoders", benchDecoders},
+        {"rng", benchRng},
+        {"ea_scaling", benchEaScaling},
+        {"candidates", benchCandidates},
+        {"local_search", benchLocalSearch},
+        {"crossover", benchCrossover},
+        {"kernels", benchKernels},
+        {"parser", benchParser},
+        {"distance_oracle", benchDistanceOracle},
+        {"batch_eval", benchBatchEval},
+        {"ea_dispatch", benchEaDispatch},
+    };
+    for (const auto& suite : suites) {
+        if (!filter.empty() && suite.first.find(filter) == std::string::npos) continue;
+        std::cout << "== " << suite.first << " ==" << std::endl;
+        suite.second();
+    }
+    if (!options.jsonPath.empty() && !writeBenchJson(options.jsonPath)) {
+        std::cerr << "Nie można zapisać " << options.jsonPath << "\n";
+        return 1;
+    }
+    return 0;
+}
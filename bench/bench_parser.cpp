@@ -0,0 +1,124 @@
+// Parser VRPLIB na dużych plikach syntetycznych: dawny parser linii (getline + stringstream +
+// unordered_map) vs readVrplib (mmap + from_chars), oraz macierze EXPLICIT. Mierzone jest samo
+// wczytanie do tablic SoA, bez macierzy odległości dla EUC_2D i bez list kandydatów.
+#include "Bench.h"
+#include "Random.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+static const char* kSuite = "parser";
+
+// Dawny parser z VRP.cpp ograniczony do wypełnienia tablic SoA (bez walidacji sekcji).
+static Problem legacyParse(const std::string& path) {
+    Problem problem{};
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("DIMENSION") != std::string::npos) {
+            std::stringstream ss(line);
+            std::string dummy; char colon;
+            ss >> dummy >> colon >> problem.dimension;
+        }
+        if (line.find("CAPACITY") != std::string::npos) {
+            std::stringstream ss(line);
+            std::string dummy; char colon;
+            ss >> dummy >> colon >> problem.capacity;
+        }
+        if (line.find("NODE_COORD_SECTION") != std::string::npos) break;
+    }
+    std::unordered_map<int, std::pair<double, double>> coords;
+    while (std::getline(in, line)) {
+        if (line.find("DEMAND_SECTION") != std::string::npos) break;
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        int id; double x, y;
+        ss >> id >> x >> y;
+        coords[id] = {x, y};
+    }
+    std::unordered_map<int, int> demands;
+    while (std::getline(in, line)) {
+        if (line.find("DEPOT_SECTION") != std::string::npos) break;
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        int id, dem;
+        ss >> id >> dem;
+        demands[id] = dem;
+    }
+    problem.demands.assign(problem.dimension + 1, 0);
+    problem.xs.assign(problem.dimension + 1, 0.0);
+    problem.ys.assign(problem.dimension + 1, 0.0);
+    for (int id = 1; id <= problem.dimension; ++id) {
+        problem.xs[id] = coords[id].first;
+        problem.ys[id] = coords[id].second;
+        problem.demands[id] = demands[id];
+    }
+    return problem;
+}
+
+// Plik EUC_2D z `n` węzłami o współrzędnych z dwoma miejscami po przecinku.
+static void writeCoordinateFile(const std::string& path, int n) {
+    ScopedRngStream stream(31);
+    std::ofstream out(path);
+    out << "NAME : parser-n" << n << "\nTYPE : CVRP\nDIMENSION : " << n
+        << "\nEDGE_WEIGHT_TYPE : EUC_2D\nCAPACITY : 100\nNODE_COORD_SECTION\n";
+    char buffer[64];
+    for (int id = 1; id <= n; ++id) {
+        std::snprintf(buffer, sizeof(buffer), " %d %.2f %.2f\n", id, randUnit() * 1000.0, randUnit() * 1000.0);
+        out << buffer;
+    }
+    out << "DEMAND_SECTION\n";
+    for (int id = 1; id <= n; ++id) out << id << " " << (id == 1 ? 0 : randInt(1, 30)) << "\n";
+    out << "DEPOT_SECTION\n 1\n -1\nEOF\n";
+}
+
+// Plik EXPLICIT z macierzą w formacie `format` (FULL_MATRIX lub LOWER_ROW), 10 wartości w linii.
+static void writeExplicitFile(const std::string& path, int n, const std::string& format) {
+    ScopedRngStream stream(37);
+    std::ofstream out(path);
+    out << "NAME : parser-explicit-n" << n << "\nTYPE : CVRP\nDIMENSION : " << n
+        << "\nEDGE_WEIGHT_TYPE : EXPLICIT\nEDGE_WEIGHT_FORMAT : " << format << "\nCAPACITY : 100\nEDGE_WEIGHT_SECTION\n";
+    const bool full = format == "FULL_MATRIX";
+    int inLine = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < (full ? n : i); ++j) {
+            out << (i == j ? 0 : randInt(1, 2000)) << (++inLine % 10 == 0 ? "\n" : " ");
+        }
+    }
+    out << "\nDEMAND_SECTION\n";
+    for (int id = 1; id <= n; ++id) out << id << " " << (id == 1 ? 0 : randInt(1, 30)) << "\n";
+    out << "DEPOT_SECTION\n 1\n -1\nEOF\n";
+}
+
+static void reportFile(const char* kernel, const std::string& name, int n, const std::string& path,
+                       const BenchStats& stats) {
+    reportBench(kSuite, kernel, name, n, stats);
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+    std::printf("%-16s %-18s %7s %11.1f MB/s\n", "", "", "", megabytes / (stats.medianNs * 1e-9));
+}
+
+void benchParser() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    const auto dir = std::filesystem::temp_directory_path();
+    for (int n : {1000, 10000, 100000}) {
+        std::string name = "coords-n" + std::to_string(n);
+        std::string path = (dir / ("vrp_bench_" + name + ".vrp")).string();
+        writeCoordinateFile(path, n);
+        reportFile("legacy_getline", name, n, path, measureStats([&] { doNotOptimize(legacyParse(path).dimension); }));
+        reportFile("mmap_from_chars", name, n, path, measureStats([&] { doNotOptimize(readVrplib(path).dimension); }));
+        std::filesystem::remove(path);
+    }
+    for (const char* format : {"FULL_MATRIX", "LOWER_ROW"}) {
+        const int n = 2000;
+        std::string name = std::string(format) + "-n" + std::to_string(n);
+        std::string path = (dir / ("vrp_bench_" + name + ".vrp")).string();
+        writeExplicitFile(path, n, format);
+        reportFile("mmap_explicit", name, n, path, measureStats([&] { doNotOptimize(readVrplib(path).dimension); }));
+        std::filesystem::remove(path);
+    }
+}
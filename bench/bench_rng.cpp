@@ -0,0 +1,50 @@
+// Koszt losowania: std::mt19937 z obiektami rozkładów vs xoshiro256** z metodą Lemire'a. Jedno
+// wywołanie pomiaru to jedno losowanie albo jedno tasowanie tablicy n elementów.
+#include "Bench.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <string>
+
+static const char* kSuite = "rng";
+
+// Wiersze mt19937 i xoshiro tej samej operacji oraz przyspieszenie xoshiro.
+static void reportPair(const std::string& operation, const std::string& instance, int n, const BenchStats& mt,
+                       const BenchStats& xo) {
+    reportBench(kSuite, "mt_" + operation, instance, n, mt);
+    reportBench(kSuite, "xo_" + operation, instance, n, xo);
+    std::printf("%-16s %-18s %7s %10.1fx speedup\n", "", "", "", mt.medianNs / xo.medianNs);
+}
+
+void benchRng() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    std::mt19937 mt(1);
+    ScopedRngStream stream(1);
+    reportPair("rand_int", "range-60", 60, measureStats([&] {
+                   std::uniform_int_distribution<int> dist(0, 59);
+                   doNotOptimize(dist(mt));
+               }),
+               measureStats([&] { doNotOptimize(randInt(0, 59)); }));
+    reportPair("rand_unit", "unit", 1, measureStats([&] {
+                   std::uniform_real_distribution<double> dist(0.0, 1.0);
+                   doNotOptimize(dist(mt));
+               }),
+               measureStats([&] { doNotOptimize(randUnit()); }));
+    for (int n : {60, 1000, 10000}) {
+        std::vector<int> data(n);
+        std::iota(data.begin(), data.end(), 0);
+        const std::string instance = "iota-n" + std::to_string(n);
+        reportPair("shuffle", instance, n, measureStats([&] {
+                       std::shuffle(data.begin(), data.end(), mt);
+                       doNotOptimize(data[0]);
+                   }),
+                   measureStats([&] {
+                       shuffleInPlace(data.data(), data.size());
+                       doNotOptimize(data[0]);
+                   }));
+    }
+}
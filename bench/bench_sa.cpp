@@ -0,0 +1,71 @@
+// Przepustowość kroku SA: pełne dekodowanie kopii permutacji vs przyrostowa ocena swap. Jedno
+// wywołanie pomiaru to jeden krok (sąsiad, ocena, akceptacja) na stanie przechodzącym między krokami.
+#include "Bench.h"
+#include "Random.h"
+#include "SwapDelta.h"
+
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+static const char* kSuite = "sa_step";
+static const double kTemp = 20.0;
+
+static BenchStats fullDecodeSteps(const Problem& problem, const std::vector<int>& start) {
+    std::vector<int> currentPerm = start;
+    double currentCost = decodePermutation(problem, currentPerm).cost;
+    const int n = static_cast<int>(currentPerm.size());
+    return measureStats([&] {
+        std::vector<int> neighbor = currentPerm;
+        int i = randInt(0, n - 1);
+        int j = randInt(0, n - 1);
+        while (j == i) j = randInt(0, n - 1);
+        std::swap(neighbor[i], neighbor[j]);
+        Solution sol = decodePermutation(problem, neighbor);
+        double delta = sol.cost - currentCost;
+        if (delta < 0 || randUnit() < std::exp(-delta / kTemp)) {
+            currentPerm = neighbor;
+            currentCost = sol.cost;
+        }
+        doNotOptimize(currentCost);
+    });
+}
+
+static BenchStats deltaSteps(const Problem& problem, const std::vector<int>& start) {
+    SwapDeltaEvaluator state(problem, start);
+    double currentCost = state.cost();
+    const int n = static_cast<int>(start.size());
+    return measureStats([&] {
+        int i = randInt(0, n - 1);
+        int j = randInt(0, n - 1);
+        while (j == i) j = randInt(0, n - 1);
+        double cost = state.applySwap(i, j);
+        double delta = cost - currentCost;
+        if (delta < 0 || randUnit() < std::exp(-delta / kTemp)) {
+            state.commit();
+            currentCost = cost;
+        } else {
+            state.undo();
+        }
+        doNotOptimize(currentCost);
+    });
+}
+
+// Wiersz wyniku i liczba kroków na sekundę z mediany.
+static void reportSteps(const char* kernel, const BenchInstance& inst, const BenchStats& stats) {
+    reportBench(kSuite, kernel, inst.name, inst.problem.dimension, stats);
+    std::printf("%-16s %-18s %7s %11.3g step/s\n", "", "", "", 1e9 / stats.medianNs);
+}
+
+void benchSaStep() {
+    std::printf("%-16s %-18s %7s %14s %12s %14s %6s\n", "kernel", "instance", "n", "median[ns]", "mad[ns]",
+                "min[ns]", "reps");
+    for (const auto& inst : loadBenchInstances({1000})) {
+        auto start = makeBenchPermutations(inst.problem, 1, 11u).front();
+        BenchStats full = fullDecodeSteps(inst.problem, start);
+        reportSteps("full_decode", inst, full);
+        BenchStats delta = deltaSteps(inst.problem, start);
+        reportSteps("swap_delta", inst, delta);
+        std::printf("%-16s %-18s %7s %10.1fx speedup\n", "", "", "", full.medianNs / delta.medianNs);
+    }
+}
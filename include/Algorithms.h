@@ -1,18 +1,27 @@
 // Deklaracje wszystkich zaimplementowanych algorytmów poszukiwań.
 #pragma once
 
+#include "Budget.h"
 #include "Config.h"
 #include "VRP.h"
 #include "Logger.h"
 
-// Uruchamia algorytm losowego przeszukiwania przez podaną liczbę iteracji.
-Solution runRandomSearch(const Problem& problem, int iterations, CSVLogger& logger);
+// Każdy algorytm kończy się także po wyczerpaniu `budget`, dolicza do niego swoje pełne oceny
+// i zaznacza w nim chwile znalezienia nowego najlepszego rozwiązania.
 
-// Uruchamia algorytm zachłanny wielokrotnie (różne starty) i zwraca najlepsze znalezione rozwiązanie.
-Solution runGreedy(const Problem& problem, int restarts, CSVLogger& logger);
+// Uruchamia algorytm losowego przeszukiwania przez random_iterations iteracji.
+Solution runRandomSearch(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget);
 
-// Uruchamia symulowane wyżarzanie zgodnie z parametrami z Config.
-Solution runSimulatedAnnealing(const Problem& problem, const Config& cfg, CSVLogger& logger);
+// Uruchamia algorytm zachłanny greedy_restarts razy (różne starty) i zwraca najlepsze znalezione rozwiązanie.
+Solution runGreedy(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget);
+
+// Uruchamia symulowane wyżarzanie zgodnie z parametrami z Config; dla sa_replicas > 1 jako
+// równoległe odpuszczanie (repliki na osobnych wątkach, logi `<run>_replica_<r>` i `<run>_exchanges`).
+Solution runSimulatedAnnealing(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget);
+
+// Nagłówek logu EA: statystyki populacji oraz ułamek dzieci bez dekodowania (pamięć kosztów lub
+// kopia rodzica) i liczba odrzuconych duplikatów przy tworzeniu danego pokolenia.
+constexpr const char* kEaLogHeader = "generation,best,avg,worst,cache_hit_rate,duplicates";
 
 // Uruchamia algorytm ewolucyjny zgodnie z parametrami z Config.
-Solution runEvolutionary(const Problem& problem, const Config& cfg, CSVLogger& logger);
+Solution runEvolutionary(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget);
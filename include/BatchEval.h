@@ -0,0 +1,19 @@
+// Wsadowa ocena wielu permutacji dekoderem greedy: każda permutacja to jedna linia wektora AVX2
+// (8) lub AVX-512 (16), odległości i zapotrzebowania są pobierane instrukcjami gather z płaskiej
+// macierzy i tablicy SoA, a cięcie tras przy przekroczeniu pojemności odbywa się maskami, bez
+// rozgałęzień. Poziom SIMD jest wybierany przy starcie według CPUID (Simd.h).
+#pragma once
+
+#include "Simd.h"
+#include "VRP.h"
+
+// Koszty dekodera greedy permutacji base[offsets[b] .. offsets[b] + length) dla b < count do
+// costs[b]; wyniki są identyczne z decodeCost (te same sumy w tej samej kolejności). Jądra wektorowe
+// działają na gęstej macierzy int32_t z indeksami mieszczącymi się w int32; w pozostałych
+// przypadkach (tryb na żądanie, inny DistanceValue) oraz dla level == Scalar liczone jest skalarnie.
+// Poziom wyższy niż obsługiwany przez procesor jest obniżany.
+void evaluateBatch(const Problem& problem, const int* base, const int* offsets, int count, int length,
+                   double* costs, SimdLevel level = detectedSimd());
+
+// Poziom SIMD, którego evaluateBatch faktycznie użyje dla problemu przy żądanym `level`.
+SimdLevel batchSimdLevel(const Problem& problem, SimdLevel level = detectedSimd());
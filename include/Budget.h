@@ -0,0 +1,100 @@
+// Budżet runu wspólny dla wszystkich algorytmów: limit czasu ściennego (budget_ms) i liczby pełnych
+// ocen (budget_evaluations), warunki wczesnego stopu (koszt docelowy, stagnacja) wraz z powodem
+// zakończenia oraz moment znalezienia najlepszego wyniku (czas i oceny do best).
+#pragma once
+
+#include "Config.h"
+
+#include <chrono>
+
+// Powód zakończenia runu.
+enum class StopReason {
+    Completed,         // wyczerpany własny licznik algorytmu (iteracje, restarty, temperatura, pokolenia)
+    TimeBudget,        // budget_ms
+    EvaluationBudget,  // budget_evaluations
+    Target,            // osiągnięty koszt docelowy (optimum * (1 + stop_target_gap))
+    Stagnation,        // stop_stagnation kroków bez poprawy najlepszego
+    Diversity,         // różnorodność populacji EA poniżej ea_stop_diversity
+};
+// Nazwa powodu w logach (completed, time_budget, ...).
+const char* stopReasonName(StopReason reason);
+
+// Sprawdzenie w pętli wewnętrznej to porównanie liczników; zegar (monotoniczny zgrubny,
+// CLOCK_MONOTONIC_COARSE na Linuksie) jest czytany co `clockStride` wywołań spend, a krok jest
+// dobierany tak, by odczyty wypadały mniej więcej co tick zegara. Na ostatnie dwa ticki przed
+// terminem odczyty przechodzą na dokładny zegar, więc limit czasu jest przekraczany o ułamek ms
+// i jeden krok algorytmu (w EA: jedno pokolenie).
+class Budget {
+  public:
+    // Bez limitów (tylko zliczanie ocen i momentu najlepszego wyniku).
+    Budget() : Budget(0.0, 0) {}
+    // Limity <= 0 oznaczają brak limitu. Czas liczy się od konstrukcji.
+    Budget(double limitMs, long long limitEvaluations);
+    // Limity i stagnacja z konfiguracji (budget_ms, budget_evaluations, stop_stagnation).
+    explicit Budget(const Config& cfg) : Budget(cfg.budgetMs, cfg.budgetEvaluations) {
+        stagnationLimit = cfg.stopStagnation;
+    }
+
+    // Czy ustawiono którykolwiek limit.
+    bool limited() const { return limitMs > 0.0 || limitEvaluations > 0; }
+    // Dolicza `count` pełnych ocen; zwraca true, gdy run ma się zakończyć.
+    bool spend(long long count = 1) {
+        used += count;
+        if (limitEvaluations > 0 && used >= limitEvaluations) stop(StopReason::EvaluationBudget);
+        if (limitMs > 0.0 && --untilClock <= 0) pollClock();
+        return stopped;
+    }
+    // Kończy krok algorytmu (iterację, restart, krok SA, pokolenie) i sprawdza stagnację;
+    // zwraca true, gdy run ma się zakończyć (z dowolnego powodu).
+    bool step() {
+        ++steps;
+        if (stagnationLimit > 0 && steps - bestStep >= stagnationLimit) stop(StopReason::Stagnation);
+        return stopped;
+    }
+    // Zatrzymuje run z podanego powodu (pierwszy powód wygrywa).
+    void stop(StopReason why) {
+        if (!stopped) reason = why;
+        stopped = true;
+    }
+    bool exhausted() const { return stopped; }
+    StopReason stopReason() const { return reason; }
+    long long stepCount() const { return steps; }
+    long long evaluations() const { return used; }
+    // Zużyta część budżetu (0..1, większa z części czasu i ocen; czas z ostatniego odczytu zegara).
+    double fraction() const;
+    // Dokładny czas od startu [ms].
+    double elapsedMs() const;
+
+    // Koszt, którego osiągnięcie kończy run (domyślnie brak celu).
+    void setTarget(double cost) { targetCost = cost; }
+    // Zapisuje czas, oceny i krok w chwili znalezienia nowego najlepszego rozwiązania `cost`.
+    void markBest(double cost);
+    double timeToBestMs() const { return bestMs; }
+    long long evaluationsToBest() const { return bestEvaluations; }
+
+    // Część budżetu dla jednego z `parts` równoległych wykonawców (wyspy EA): ten sam start,
+    // limit czasu, cel i stagnacja, 1/parts limitu ocen.
+    Budget share(int parts) const;
+    // Dolicza oceny części. Dla bestHere przejmuje jej czas do best, kroki i powód zakończenia,
+    // a oceny do best skaluje liczbą części (części liczą równolegle w podobnym tempie).
+    void absorb(const Budget& part, int parts, bool bestHere);
+
+  private:
+    void pollClock();
+
+    double limitMs;
+    long long limitEvaluations;
+    std::chrono::steady_clock::time_point start;
+    long long used = 0;
+    bool stopped = false;
+    StopReason reason = StopReason::Completed;
+    double targetCost;
+    long long stagnationLimit = 0;  // 0 - bez stopu przy stagnacji
+    long long steps = 0;
+    long long bestStep = 0;
+    int clockStride = 1;       // co ile wywołań spend czytamy zegar
+    int untilClock = 1;
+    double lastClockMs = 0.0;  // czas z ostatniego odczytu zegara zgrubnego
+    double bestMs = 0.0;
+    long long bestEvaluations = 0;
+};
@@ -1,8 +1,10 @@
 // Prosty nagłówek z definicją struktury konfiguracji i loadera z pliku ini.
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Struktura Config przechowuje wszystkie parametry sterujące programem.
 struct Config {
@@ -32,6 +34,22 @@ struct Config {
     double saCoolingRate;
     // Parametry SA: iteracji na jedną temperaturę.
     int saIterations;
+    // Przy ustawionym budżecie SA chłodzi według zużytej części budżetu (od sa_initial_temp do
+    // sa_min_temp na końcu budżetu) zamiast stałym sa_cooling_rate.
+    bool saAutoCooling;
+    // Równoległe odpuszczanie (parallel tempering): liczba replik SA, każda na własnym wątku w stałej
+    // temperaturze drabiny od sa_min_temp do sa_initial_temp; 1 wyłącza (zwykłe chłodzenie).
+    // Repliki czekają na siebie na barierze, więc każda musi mieć własny wątek: pula replik powstaje
+    // w każdym równoległym runie i program używa do threads x sa_replicas wątków (przy iloczynie
+    // większym niż liczba rdzeni - ostrzeżenie z configWarnings).
+    int saReplicas;
+    // Drabina temperatur: geometric (stała, geometryczna) lub adaptive (odstępy dostrajane do
+    // sa_target_swap_rate przy zachowanych końcach drabiny).
+    std::string saLadder;
+    // Co ile kroków repliki próbują wymiany stanów z sąsiadami na drabinie.
+    int saExchangeInterval;
+    // Docelowy ułamek przyjętych wymian między sąsiednimi temperaturami (sa_ladder=adaptive).
+    double saTargetSwapRate;
     // Parametry EA: rozmiar populacji.
     int eaPopulation;
     // Parametry EA: liczba pokoleń.
@@ -44,7 +62,7 @@ struct Config {
     int eaTournament;
     // Parametry EA: liczba osobników elitarnych.
     int eaElites;
-    // Parametry EA: wybór operatora krzyżowania (np. ox/pmx/cx).
+    // Parametry EA: wybór operatora krzyżowania (ox/pmx/cx/erx/eax).
     std::string eaCrossoverType;
     // Parametry EA: wybór operatora mutacji (np. swap/inversion).
     std::string eaMutationType;
@@ -52,10 +70,92 @@ struct Config {
     double eaGreedyInitFraction;
     // Prawdopodobieństwo uruchomienia lokalnego ulepszania 2-opt.
     double eaTwoOptRate;
+    // Lokalne ulepszanie dzieci EA (z prawdopodobieństwem ea_two_opt_rate): two_opt (jedna losowa
+    // próba 2-opt na permutacji) lub routes (przeszukiwanie lokalne na trasach do optimum lokalnego).
+    // Dziecko po LS jest oceniane dekoderem, więc routes najlepiej działa z decoder=split.
+    std::string eaLocalSearch;
+    // Liczba wpisów pamięci kosztów EA (skrót permutacji -> koszt); 0 wyłącza pamięć.
+    int eaCacheSize;
+    // Czy EA losuje dziecko ponownie, gdy jest duplikatem osobnika bieżącej populacji.
+    bool eaRejectDuplicates;
+    // Strategia przeszukiwania lokalnego na trasach: first lub best (improvement).
+    std::string lsStrategy;
+    // Czy SA szlifuje najlepsze znalezione rozwiązanie przeszukiwaniem lokalnym na trasach.
+    bool saLocalSearch;
+    // Dekoder permutacji na trasy: greedy (cięcie przy przekroczeniu pojemności) lub split (optymalny podział).
+    std::string decoder;
+    // Dla decoder=split: ogranicza liczbę tras do k z nazwy instancji (np. A-n32-k5 -> 5).
+    bool splitFleetLimit;
+    // Wsadowa ocena permutacji dekoderem greedy (BatchEval.h) w przeszukiwaniu losowym i EA; wyniki
+    // są identyczne jak przy ocenie pojedynczo.
+    bool batchEvaluation;
+    // Ziarno generatora; każdy run dostaje własny strumień z (seed, instancja, algorytm, run).
+    // 0 oznacza ziarno losowe (wypisywane na wyjście, aby dało się powtórzyć eksperyment).
+    std::uint64_t seed;
+    // Długość list kandydatów (k najbliższych klientów) używanych przez konstrukcję zachłanną i ruchy.
+    int candidates;
+    // Przechowywanie odległości: auto (gęsta macierz, jeśli zajmie najwyżej distance_dense_limit_mb
+    // i połowę dostępnej pamięci, inaczej liczenie ze współrzędnych), dense lub on_demand.
+    std::string distanceMode;
+    double distanceDenseLimitMb;
+    // Liczba wątków wykonujących uruchomienia (0 oznacza liczbę rdzeni).
+    int threads;
+    // Liczba wątków generujących potomstwo w jednym runie EA (1 = sekwencyjnie, 0 = liczba rdzeni).
+    // Dla wartości innych niż 1 dzieci powstają we fragmentach z własnymi strumieniami losowymi,
+    // więc wynik nie zależy od liczby wątków (ale różni się od trybu sekwencyjnego).
+    // Pula runu EA powstaje w każdym runie wykonywanym równolegle przez pulę `threads`, więc program
+    // używa do threads x ea_threads wątków; przy iloczynie większym niż liczba rdzeni program
+    // wypisuje ostrzeżenie (configWarnings).
+    int eaThreads;
+    // Model wyspowy EA: liczba wysp (populacji na osobnych wątkach); 1 wyłącza model.
+    // Migracja jest asynchroniczna, więc wyniki z wyspami nie są powtarzalne dla danego seed.
+    int eaIslands;
+    // Co ile pokoleń wyspa wysyła migrantów.
+    int eaMigrationInterval;
+    // Liczba najlepszych osobników wysyłanych w jednej migracji (zastępują najgorszych u odbiorcy).
+    int eaMigrationSize;
+    // Topologia migracji: ring (do następnej wyspy) lub random (do losowej innej wyspy).
+    std::string eaTopology;
+    // Format logów przebiegów: csv (tekst) lub binary (kolumnowy plik .vlog).
+    std::string logFormat;
+    // Tryb logów: per_run (plik na każdy run) lub aggregate (jedna krzywa na instancję i algorytm).
+    std::string logMode;
+    // W trybie aggregate: ile pierwszych runów zapisuje też pełny log przebiegu.
+    int rawLogRuns;
+    // Które wiersze logów przebiegów zapisywać: all, every (co log_every kroków), improvement.
+    std::string logPolicy;
+    // Krok zapisu dla log_policy=every.
+    int logEvery;
+    // Maksymalna liczba punktów krzywej zagregowanej (krok próbkowania dobierany do długości runu).
+    int aggregatePoints;
+    // Czy zapisywać pomiary każdego runu z pełnym logiem do pliku <alg>_run_<n>.json (czas, oceny/s,
+    // fazy EA, akceptacja SA, alokacje).
+    bool runMetrics;
+    // Czy mierzyć liczniki sprzętowe (cykle, chybienia cache) przez perf_event_open (tylko Linux,
+    // tylko wątek runu; przy braku uprawnień pole jest pomijane).
+    bool perfCounters;
+    // Budżet każdego runu: czas ścienny [ms] i liczba pełnych ocen (dekodowań, kroków SA); 0 - bez
+    // limitu. Run kończy się po wyczerpaniu budżetu albo własnych liczników (iteracje, restarty,
+    // pokolenia, temperatura), co nastąpi wcześniej. Limit czasu czyni wyniki niepowtarzalnymi.
+    double budgetMs;
+    long long budgetEvaluations;
+    // Wczesny stop po osiągnięciu kosztu optimum * (1 + stop_target_gap), gdy optimum instancji
+    // jest znane; wartość ujemna wyłącza.
+    double stopTargetGap;
+    // Wczesny stop po tylu krokach (iteracjach, restartach, krokach SA, pokoleniach) bez poprawy
+    // najlepszego rozwiązania; 0 wyłącza.
+    int stopStagnation;
+    // Wczesny stop EA, gdy różnorodność populacji (średni ułamek krawędzi permutacji nieobecnych
+    // u najlepszego osobnika pokolenia) spadnie poniżej progu; 0 wyłącza.
+    double eaStopDiversity;
     // Flaga pozwalająca na logowanie rozbudowane.
     bool verbose;
 };
 
+// Ostrzeżenia o nastawach, które działają, ale są zapewne pomyłką (np. więcej wątków niż rdzeni
+// przez pule zagnieżdżone w równoległych runach).
+std::vector<std::string> configWarnings(const Config& cfg);
+
 // Prosta klasa wczytująca plik konfiguracyjny w formacie key=value.
 class ConfigLoader {
   public:
@@ -0,0 +1,56 @@
+// Agregacja krzywych zbieżności (best w kolejnych krokach) z wielu uruchomień jednego algorytmu.
+#pragma once
+
+#include "Stats.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Krzywa jednego runu: wartość best co `stride` kroków (krok 0, stride, 2*stride, ...).
+struct RunCurve {
+    int stride = 1;
+    std::vector<double> best;
+
+    // Zapisuje punkt, jeśli krok trafia w siatkę próbkowania.
+    void record(long long step, double value) {
+        if (step % stride == 0) best.push_back(value);
+    }
+};
+
+// Zbiera krzywe wszystkich runów (instancja, algorytm) i liczy w każdym punkcie średnią,
+// odchylenie, min/max oraz kwantyle 10/50/90% (P²). Krzywe są włączane w kolejności numerów
+// runów, więc wynik (także kwantyle P²) nie zależy od kolejności kończenia się wątków.
+class CurveAggregator {
+  public:
+    // runs - liczba runów, stride - co ile kroków próbkujemy krzywą.
+    CurveAggregator(int runs, int stride);
+
+    // Krok próbkowania dla krzywych runów.
+    int stride() const { return sampleStride; }
+    // Przekazuje krzywą runu (bezpieczne wątkowo); wolne krzywe są od razu włączane do statystyk.
+    void submit(int run, std::vector<double> curve);
+    // Zapisuje plik CSV: step,runs,mean,std,min,max,q10,median,q90.
+    bool write(const std::string& path) const;
+
+  private:
+    // Statystyki jednego punktu krzywej.
+    struct Point {
+        RunningStats stats;
+        P2Quantile q10{0.1};
+        P2Quantile median{0.5};
+        P2Quantile q90{0.9};
+    };
+
+    void consume(const std::vector<double>& curve);
+
+    int sampleStride;
+    mutable std::mutex mutex;
+    int nextRun = 0;                         // następny run do włączenia
+    std::vector<std::vector<double>> waiting;  // krzywe runów czekających na wcześniejsze
+    std::vector<char> ready;
+    std::vector<Point> points;
+};
+
+// Krok próbkowania, przy którym krzywa o `steps` krokach ma co najwyżej `maxPoints` punktów.
+int curveStride(long long steps, int maxPoints);
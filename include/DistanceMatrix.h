@@ -0,0 +1,96 @@
+// Płaska macierz odległości w jednym ciągłym, wyrównanym do linii cache buforze.
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Typ elementu macierzy wybierany przy kompilacji (make DIST_TYPE=double|float|int32_t|uint16_t).
+#ifndef VRP_DISTANCE_T
+#define VRP_DISTANCE_T int32_t
+#endif
+
+// Rozmiar linii cache, do którego wyrównujemy bufory i długość wierszy.
+constexpr std::size_t kCacheLine = 64;
+
+// Alokator zwracający pamięć wyrównaną do Align bajtów (dla std::vector).
+template <typename T, std::size_t Align = kCacheLine>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* ptr, std::size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t(Align));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+// Wektor z pamięcią wyrównaną do linii cache.
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Macierz size x size zapisana wierszami; każdy wiersz zaczyna się na granicy linii cache.
+template <typename T>
+class FlatDistanceMatrix {
+  public:
+    using value_type = T;
+
+    FlatDistanceMatrix() = default;
+
+    // Alokuje macierz size x size wypełnioną zerami.
+    void resize(int size) {
+        constexpr std::size_t perLine = kCacheLine / sizeof(T);
+        dim = size;
+        stride = (static_cast<std::size_t>(size) + perLine - 1) / perLine * perLine;
+        buffer.assign(stride * static_cast<std::size_t>(size), T{});
+    }
+
+    // Zapisuje odległość; dla typów całkowitych sprawdza, czy wartość jest całkowita i mieści się w typie.
+    void set(int i, int j, double value) {
+        if constexpr (std::is_integral_v<T>) {
+            if (value != std::floor(value) || value < static_cast<double>(std::numeric_limits<T>::min()) ||
+                value > static_cast<double>(std::numeric_limits<T>::max())) {
+                throw std::runtime_error("Odległość " + std::to_string(value) +
+                                         " nie mieści się w typie elementu macierzy odległości");
+            }
+        }
+        buffer[static_cast<std::size_t>(i) * stride + j] = static_cast<T>(value);
+    }
+
+    T operator()(int i, int j) const { return buffer[static_cast<std::size_t>(i) * stride + j]; }
+
+    // Wskaźnik na początek wiersza i (wyrównany do linii cache).
+    const T* row(int i) const { return buffer.data() + static_cast<std::size_t>(i) * stride; }
+
+    int size() const { return dim; }
+    std::size_t rowStride() const { return stride; }
+    std::size_t bytes() const { return buffer.size() * sizeof(T); }
+
+  private:
+    int dim = 0;              // liczba wierszy/kolumn
+    std::size_t stride = 0;   // długość wiersza w elementach (z dopełnieniem)
+    AlignedVector<T> buffer;  // dane wierszami
+};
+
+using DistanceValue = VRP_DISTANCE_T;
+using DistanceMatrix = FlatDistanceMatrix<DistanceValue>;
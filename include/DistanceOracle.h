@@ -0,0 +1,112 @@
+// Odległości między węzłami za jednym interfejsem: gęsta macierz (FlatDistanceMatrix) albo liczenie
+// na żądanie z kopii współrzędnych (SoA) dla instancji, których macierz nie zmieściłaby się w pamięci.
+#pragma once
+
+#include "DistanceMatrix.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Sposób przechowywania odległości (klucz distance_mode).
+enum class DistanceMode {
+    Auto,      // gęsta macierz, jeśli mieści się w limicie i w połowie dostępnej pamięci
+    Dense,     // zawsze gęsta macierz
+    OnDemand   // zawsze liczenie ze współrzędnych (dla EXPLICIT niedostępne - zostaje macierz)
+};
+
+// Zamienia nazwę trybu z konfiguracji (auto/dense/on_demand) na DistanceMode; nieznana nazwa daje Auto.
+DistanceMode parseDistanceMode(const std::string& name);
+
+// Wybór trybu przy budowie odległości instancji.
+struct DistanceSettings {
+    DistanceMode mode = DistanceMode::Auto;
+    double denseLimitMb = 1024.0;  // największa gęsta macierz wybierana automatycznie
+};
+
+// Czy dla macierzy `size` x `size` wybrać tryb gęsty (rozmiar wg FlatDistanceMatrix, dostępna
+// pamięć z /proc/meminfo lub sysconf).
+bool preferDenseDistances(int size, const DistanceSettings& settings);
+
+// Nazwa jądra SIMD używanego w trybie na żądanie (avx512, avx2 lub scalar), wybranego przy starcie
+// programu według CPUID.
+const char* distanceKernelName();
+
+// W trybie na żądanie odległość to zaokrąglona do najbliższej (ceiling: w górę) odległość
+// euklidesowa, liczona dokładnie jak przy budowie macierzy, więc oba tryby dają identyczne wyniki.
+class DistanceOracle {
+  public:
+    // Tryb gęsty: macierz size x size wypełniona zerami.
+    void resize(int size) {
+        onDemandMode = false;
+        xs = AlignedVector<double>();
+        ys = AlignedVector<double>();
+        matrix.resize(size);
+        dim = size;
+    }
+    // Zapisuje odległość w trybie gęstym (z kontrolą typu elementu jak FlatDistanceMatrix::set).
+    void set(int i, int j, double value) { matrix.set(i, j, value); }
+
+    // Tryb na żądanie: kopiuje współrzędne węzłów 0..size-1 i zwalnia macierz. Rzuca wyjątek, gdy
+    // największa możliwa odległość nie mieści się w DistanceValue.
+    void computeOnDemand(const double* x, const double* y, int size, bool ceiling);
+
+    bool onDemand() const { return onDemandMode; }
+    // Gęsta macierz (dla jąder pobierających odległości bezpośrednio) albo nullptr w trybie na żądanie.
+    const DistanceMatrix* dense() const { return onDemandMode ? nullptr : &matrix; }
+
+    // Gałąź trybu jest przewidywalna, a liczenie na żądanie jest poza linią, żeby pętle trybu
+    // gęstego pozostały takie jak na samej macierzy.
+    DistanceValue operator()(int i, int j) const {
+        if (__builtin_expect(onDemandMode, 0)) return pairOnDemand(i, j);
+        return matrix(i, j);
+    }
+
+    // Wywołuje fn z obiektem odległości (operator()(i, j)): samą macierzą w trybie gęstym, a w trybie
+    // na żądanie tym obiektem. Gorące pętle sprawdzają wtedy tryb raz, a nie przy każdym dostępie.
+    template <typename Fn>
+    decltype(auto) visit(Fn&& fn) const {
+        if (onDemandMode) return fn(*this);
+        return fn(matrix);
+    }
+
+    // Wiersz i. W trybie na żądanie liczony wektorowo do pamięci podręcznej wątku (kilka ostatnich
+    // wierszy); wskaźnik jest ważny do kolejnego wywołania row na tym wątku.
+    const DistanceValue* row(int i) const { return onDemandMode ? cachedRow(i) : matrix.row(i); }
+
+    // Odległości z `from` do węzłów ids[0..count) (np. lista kandydatów, trasa od depo) do out.
+    void gather(int from, const int* ids, int count, double* out) const {
+        if (onDemandMode) return gatherOnDemand(from, ids, count, out);
+        const DistanceValue* values = matrix.row(from);
+        for (int k = 0; k < count; ++k) out[k] = values[ids[k]];
+    }
+    // Długość trasy depot -> ids[0] -> ... -> ids[count - 1] -> depot (0 dla pustej trasy).
+    double routeLength(int depot, const int* ids, int count) const {
+        if (onDemandMode) return routeOnDemand(depot, ids, count);
+        double total = 0.0;
+        int prev = depot;
+        for (int k = 0; k < count; ++k) {
+            total += matrix(prev, ids[k]);
+            prev = ids[k];
+        }
+        return total + matrix(prev, depot);
+    }
+
+    int size() const { return dim; }
+    // Pamięć danych odległości (macierz albo współrzędne).
+    std::size_t bytes() const { return onDemandMode ? (xs.size() + ys.size()) * sizeof(double) : matrix.bytes(); }
+
+  private:
+    DistanceValue pairOnDemand(int i, int j) const;
+    const DistanceValue* cachedRow(int i) const;
+    void gatherOnDemand(int from, const int* ids, int count, double* out) const;
+    double routeOnDemand(int depot, const int* ids, int count) const;
+
+    DistanceMatrix matrix;        // tryb gęsty
+    AlignedVector<double> xs;     // tryb na żądanie: współrzędne wg id
+    AlignedVector<double> ys;
+    int dim = 0;
+    bool onDemandMode = false;
+    bool ceiling = false;         // CEIL_2D
+    std::uint64_t cacheKey = 0;   // identyfikator współrzędnych w pamięci podręcznej wierszy
+};
@@ -0,0 +1,132 @@
+// Polityki operatorów EA: krzyżowanie, mutacja, ulepszanie dziecka i dekoder jako typy ze statyczną
+// funkcją apply/cost. EvolutionRun wybiera je raz przy starcie (dispatchEaPolicies) i konkretyzuje
+// szablonem pętlę tworzenia potomstwa, więc na dziecko nie ma porównań nazw ani przełączania po
+// rodzaju operatora. Nowy operator to nowa klasa polityki i jej przypadek w dispatchEaPolicies.
+#pragma once
+
+#include "FitnessCache.h"
+#include "LocalSearch.h"
+#include "Operators.h"
+#include "VRP.h"
+
+#include <cstdint>
+#include <vector>
+
+// Krzyżowania: apply(problem, p1, p2, n, child, ws) jak funkcje z Operators.h.
+struct OxCrossover {
+    static void apply(const Problem&, const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+        orderedCrossover(p1, p2, n, child, ws);
+    }
+};
+struct PmxCrossover {
+    static void apply(const Problem&, const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+        pmxCrossover(p1, p2, n, child, ws);
+    }
+};
+struct CxCrossover {
+    static void apply(const Problem&, const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+        cycleCrossover(p1, p2, n, child, ws);
+    }
+};
+struct ErxCrossover {
+    static void apply(const Problem&, const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+        edgeRecombinationCrossover(p1, p2, n, child, ws);
+    }
+};
+struct EaxCrossover {
+    static void apply(const Problem& problem, const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+        edgeAssemblyCrossover(problem, p1, p2, n, child, ws);
+    }
+};
+
+// Mutacje: apply(perm, hash, rate) aktualizuje skrót i zwraca, czy zmieniła permutację.
+struct SwapMutation {
+    static bool apply(std::vector<int>& perm, std::uint64_t& hash, double rate) { return mutateSwap(perm, hash, rate); }
+};
+struct InversionMutation {
+    static bool apply(std::vector<int>& perm, std::uint64_t& hash, double rate) {
+        return mutateInversion(perm, hash, rate);
+    }
+};
+
+// Bufory i ustawienia ulepszania dziecka jednego wątku.
+struct EducationContext {
+    const Problem& problem;
+    LocalSearch* localSearch;  // silnik LS (RouteEducation)
+    Solution& routes;          // zdekodowane dziecko poprawiane przez LS
+    LsStrategy strategy;
+    DecoderType decoder;
+};
+
+// Ulepszanie dziecka: apply(child, hash, ctx) aktualizuje skrót i zwraca, czy zmieniło permutację;
+// kRoutes - czy po zmianie ctx.routes zawiera trasy dziecka wraz z kosztem.
+// TwoOptEducation - jedna losowa próba 2-opt na permutacji (ea_local_search=two_opt).
+struct TwoOptEducation {
+    static constexpr bool kRoutes = false;
+    static bool apply(std::vector<int>& child, std::uint64_t& hash, EducationContext& ctx) {
+        return twoOptOnce(child, hash, ctx.problem);
+    }
+};
+// RouteEducation - dekodowanie, LS do optimum lokalnego, trasy sklejone z powrotem w permutację
+// (ea_local_search=routes).
+struct RouteEducation {
+    static constexpr bool kRoutes = true;
+    static bool apply(std::vector<int>& child, std::uint64_t& hash, EducationContext& ctx) {
+        ctx.routes = decodePermutation(ctx.problem, child, ctx.decoder);
+        if (ctx.localSearch->improve(ctx.routes, ctx.strategy) == 0) return false;
+        child.swap(ctx.routes.perm);
+        hash = permutationHash(child.data(), static_cast<int>(child.size()));
+        return true;
+    }
+};
+
+// Dekodery: cost(problem, perm, decoder); kBatchable - czy koszty można liczyć evaluateBatch;
+// kKeepsRoutes - czy dekodowanie permutacji sklejonej z tras LS kosztuje najwyżej tyle co te trasy.
+// Split jest optymalny dla ustalonej kolejności, a greedy dzieli sklejoną permutację inaczej (dopełnia
+// trasy klientami następnej), więc przy greedy kosztem dziecka po RouteEducation jest koszt tras.
+struct GreedyDecoding {
+    static constexpr bool kBatchable = true;
+    static constexpr bool kKeepsRoutes = false;
+    static double cost(const Problem& problem, const std::vector<int>& perm, DecoderType) {
+        return greedyCost(problem, perm.data(), static_cast<int>(perm.size()));
+    }
+};
+struct SplitDecoding {
+    static constexpr bool kBatchable = false;
+    static constexpr bool kKeepsRoutes = true;
+    static double cost(const Problem& problem, const std::vector<int>& perm, DecoderType decoder) {
+        return decodeCost(problem, perm, decoder);
+    }
+};
+
+// Wywołuje fn(Crossover{}, Mutation{}, Education{}, Decoding{}) z politykami odpowiadającymi
+// ustawieniom runu; fn zwraca ten sam typ dla wszystkich kombinacji (np. wskaźnik na konkretyzację).
+template <typename Fn>
+decltype(auto) dispatchEaPolicies(CrossoverType crossover, MutationType mutation, bool routeEducation,
+                                  DecoderType decoder, Fn&& fn) {
+    auto withDecoding = [&](auto c, auto m, auto e) {
+        if (decoder == DecoderType::Greedy) return fn(c, m, e, GreedyDecoding{});
+        return fn(c, m, e, SplitDecoding{});
+    };
+    auto withEducation = [&](auto c, auto m) {
+        if (routeEducation) return withDecoding(c, m, RouteEducation{});
+        return withDecoding(c, m, TwoOptEducation{});
+    };
+    auto withMutation = [&](auto c) {
+        if (mutation == MutationType::Inversion) return withEducation(c, InversionMutation{});
+        return withEducation(c, SwapMutation{});
+    };
+    switch (crossover) {
+        case CrossoverType::PartiallyMapped: return withMutation(PmxCrossover{});
+        case CrossoverType::Cycle: return withMutation(CxCrossover{});
+        case CrossoverType::EdgeRecombination: return withMutation(ErxCrossover{});
+        case CrossoverType::EdgeAssembly: return withMutation(EaxCrossover{});
+        case CrossoverType::Ordered: break;
+    }
+    return withMutation(OxCrossover{});
+}
@@ -0,0 +1,120 @@
+// Skrót permutacji aktualizowany w O(1) przy mutacjach oraz pamięć podręczna kosztów bez blokad.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+// Skrót permutacji to XOR kluczy jej krawędzi nieskierowanych (z depo na obu końcach, jak w trasie)
+// oraz klucza pierwszego genu, który odróżnia permutację od jej odwrócenia (dekoder greedy nie jest
+// symetryczny). Zamiana i odwrócenie segmentu zmieniają tylko kilka krawędzi, więc aktualizacja
+// skrótu kosztuje O(1).
+namespace permhash {
+
+// Mieszanie splitmix64 (finalizer).
+inline std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Klucz krawędzi nieskierowanej; -1 oznacza depo na końcu permutacji.
+inline std::uint64_t edgeKey(int u, int v) {
+    if (u > v) std::swap(u, v);
+    return mix((static_cast<std::uint64_t>(static_cast<std::uint32_t>(u)) << 32) | static_cast<std::uint32_t>(v));
+}
+
+// Klucz pierwszego genu (przestrzeń rozłączna z kluczami krawędzi).
+inline std::uint64_t startKey(int v) {
+    return mix((0xfffffffeULL << 32) ^ static_cast<std::uint32_t>(v) ^ 0x5bd1e995ULL);
+}
+
+}  // namespace permhash
+
+// Pełny skrót permutacji, O(n).
+inline std::uint64_t permutationHash(const int* perm, int n) {
+    if (n == 0) return 0;
+    std::uint64_t h = permhash::startKey(perm[0]) ^ permhash::edgeKey(-1, perm[0]) ^ permhash::edgeKey(perm[n - 1], -1);
+    for (int i = 0; i + 1 < n; ++i) h ^= permhash::edgeKey(perm[i], perm[i + 1]);
+    return h;
+}
+
+// Skrót po zamianie genów na pozycjach i, j. Wywoływać przed zamianą.
+inline std::uint64_t hashAfterSwap(std::uint64_t h, const int* perm, int n, int i, int j) {
+    if (i == j) return h;
+    if (i > j) std::swap(i, j);
+    auto at = [&](int p, bool swapped) {
+        if (p < 0 || p >= n) return -1;
+        if (swapped && p == i) return perm[j];
+        if (swapped && p == j) return perm[i];
+        return perm[p];
+    };
+    // Krawędzie (L, L+1) dotknięte zamianą; dla sąsiednich pozycji krawędź (i, j) jest wspólna.
+    const int lefts[4] = {i - 1, i, j - 1, j};
+    for (int e = 0; e < 4; ++e) {
+        if (e == 2 && j == i + 1) continue;
+        int left = lefts[e];
+        h ^= permhash::edgeKey(at(left, false), at(left + 1, false)) ^
+             permhash::edgeKey(at(left, true), at(left + 1, true));
+    }
+    if (i == 0) h ^= permhash::startKey(perm[0]) ^ permhash::startKey(perm[j]);
+    return h;
+}
+
+// Skrót po odwróceniu segmentu [i, k]. Wywoływać przed odwróceniem.
+inline std::uint64_t hashAfterReverse(std::uint64_t h, const int* perm, int n, int i, int k) {
+    if (i >= k) return h;
+    int before = i > 0 ? perm[i - 1] : -1;
+    int after = k + 1 < n ? perm[k + 1] : -1;
+    h ^= permhash::edgeKey(before, perm[i]) ^ permhash::edgeKey(before, perm[k]);
+    h ^= permhash::edgeKey(perm[k], after) ^ permhash::edgeKey(perm[i], after);
+    if (i == 0) h ^= permhash::startKey(perm[0]) ^ permhash::startKey(perm[k]);
+    return h;
+}
+
+// Ograniczona pamięć podręczna kosztów (skrót -> koszt), bezpieczna dla wielu wątków bez blokad.
+// Wpis to para (skrót ^ dane, dane); rozerwany zapis innego wątku daje niezgodny XOR i jest
+// traktowany jak chybienie. Kolizje wypierają starsze wpisy (mapowanie bezpośrednie).
+class FitnessCache {
+  public:
+    // entries zaokrąglane w górę do potęgi dwójki; 0 wyłącza pamięć.
+    explicit FitnessCache(std::size_t entries) {
+        if (entries == 0) return;
+        std::size_t size = 1;
+        while (size < entries) size <<= 1;
+        table = std::make_unique<Entry[]>(size);
+        mask = size - 1;
+    }
+
+    bool enabled() const { return table != nullptr; }
+
+    // Zwraca true i koszt, jeśli skrót jest w pamięci.
+    bool lookup(std::uint64_t hash, double& cost) const {
+        const Entry& entry = table[hash & mask];
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != hash || (check == 0 && data == 0)) return false;
+        std::memcpy(&cost, &data, sizeof cost);
+        return true;
+    }
+
+    void store(std::uint64_t hash, double cost) {
+        std::uint64_t data;
+        std::memcpy(&data, &cost, sizeof data);
+        Entry& entry = table[hash & mask];
+        entry.data.store(data, std::memory_order_relaxed);
+        entry.check.store(hash ^ data, std::memory_order_relaxed);
+    }
+
+  private:
+    struct Entry {
+        std::atomic<std::uint64_t> check{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+    std::unique_ptr<Entry[]> table;
+    std::size_t mask = 0;
+};
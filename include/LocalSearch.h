@@ -0,0 +1,74 @@
+// Przeszukiwanie lokalne na zdekodowanych trasach: relocate/Or-opt, swap, 2-opt, 2-opt*.
+#pragma once
+
+#include "VRP.h"
+
+#include <vector>
+
+// Sposób wyboru ruchu.
+enum class LsStrategy {
+    FirstImprovement,  // pierwszy poprawiający ruch dla pary (u, v) jest od razu stosowany
+    BestImprovement    // każdy przebieg stosuje najlepszy ruch z całego sąsiedztwa
+};
+
+// Zamienia nazwę strategii z konfiguracji (first/best) na LsStrategy; nieznana nazwa daje FirstImprovement.
+LsStrategy parseLsStrategy(const std::string& name);
+
+// Silnik przeszukiwania lokalnego. Trzyma trasy z ładunkami prefiksowymi i pozycjami klientów,
+// więc każdy ruch jest oceniany w O(1); sprawdzane są tylko pary (u, v), gdzie v jest na liście
+// kandydatów u (Problem::candidates). Zakłada symetryczną macierz odległości.
+// Obiekt jest buforem roboczym wielokrotnego użytku (jeden na wątek).
+class LocalSearch {
+  public:
+    explicit LocalSearch(const Problem& problem);
+
+    // Poprawia rozwiązanie do optimum lokalnego (wszystkie trasy spełniają ograniczenie pojemności
+    // po każdym ruchu). Aktualizuje perm, routeStarts i cost; zwraca liczbę zastosowanych ruchów.
+    int improve(Solution& solution, LsStrategy strategy);
+
+  private:
+    // Rodzaj ruchu.
+    enum class MoveType { None, Relocate, Swap, TwoOpt, TwoOptStarTails, TwoOptStarHeads };
+
+    // Ruch z pozycjami w chwili oceny; pos = -1 oznacza depo na początku trasy.
+    struct Move {
+        MoveType type = MoveType::None;
+        int ru = 0, pu = 0, lenU = 1;
+        int rv = 0, pv = 0, lenV = 1;
+        bool reversed = false;
+        double delta = 0.0;
+    };
+
+    void load(const Solution& solution);
+    void store(Solution& solution) const;
+    // Przelicza pozycje, ładunki prefiksowe i ładunek trasy r.
+    void refreshRoute(int r);
+
+    // Węzeł na pozycji p trasy r (depo dla p < 0 lub p >= długość).
+    int nodeAt(int r, int p) const {
+        const std::vector<int>& route = routes[r];
+        return p < 0 || p >= static_cast<int>(route.size()) ? problem.depotId : route[p];
+    }
+    // Ładunek trasy r od początku do pozycji p włącznie (0 dla p < 0).
+    int prefixLoad(int r, int p) const { return p < 0 ? 0 : cumLoad[routes[r][p]]; }
+    double dist(int a, int b) const { return static_cast<double>(problem.distances(a, b)); }
+
+    // Ocenia wszystkie ruchy tworzące krawędź między u a v i zapamiętuje najlepszy w best.
+    void evaluatePair(int ru, int pu, int rv, int pv, Move& best) const;
+    void evaluateRelocate(int ru, int pu, int rv, int pv, Move& best) const;
+    void evaluateSwap(int ru, int pu, int rv, int pv, Move& best) const;
+    void evaluateTwoOpt(int r, int pu, int pv, Move& best) const;
+    void evaluateTwoOptStar(int ru, int pu, int rv, int pv, Move& best) const;
+    // Przegląda kandydatów klienta u; zwraca true, jeśli zastosowano ruch (tryb first).
+    bool scanCustomer(int u, LsStrategy strategy, Move& best);
+    void apply(const Move& move);
+
+    const Problem& problem;
+    std::vector<std::vector<int>> routes;   // klienci kolejnych tras (bez depo)
+    std::vector<int> routeLoad;             // ładunek trasy
+    std::vector<int> routeOf;               // trasa klienta (wg id)
+    std::vector<int> posOf;                 // pozycja klienta w trasie (wg id)
+    std::vector<int> cumLoad;               // ładunek od początku trasy do klienta włącznie (wg id)
+    std::vector<int> order;                 // kolejność przeglądania klientów (losowana)
+    std::vector<int> buffer;                // bufor do przebudowy tras
+};
@@ -1,21 +1,143 @@
-// Prosty logger zapisujący dane do plików CSV.
+// Logger przebiegów: wiersze liczbowe trafiają do bufora pierścieniowego w pamięci,
+// a formatowanie i zapis do pliku (CSV albo binarny kolumnowy) wykonuje wątek w tle.
 #pragma once
 
+#include "Curve.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <memory>
 #include <string>
+#include <vector>
+
+// Maksymalna liczba kolumn w wierszu logu.
+constexpr int kMaxLogColumns = 8;
+
+// Format pliku logu.
+enum class LogFormat {
+    Csv,     // tekst: nagłówek i wiersze rozdzielone przecinkami
+    Binary   // plik .vlog: nagłówek i bloki kolumn float64 (opis w Logger.cpp)
+};
 
-// Klasa CSVLogger otwiera plik i pozwala dopisać wiersze.
+// Które wiersze trafiają do pliku logu.
+enum class LogPolicy {
+    All,          // każdy wiersz
+    Every,        // co N-ty krok (pierwsza kolumna podzielna przez N)
+    Improvement   // tylko gdy spada best (druga kolumna)
+};
+
+// Zamienia nazwę formatu z configu (csv|binary) na LogFormat; rzuca przy nieznanej nazwie.
+LogFormat parseLogFormat(const std::string& name);
+// Rozszerzenie pliku logu dla formatu (".csv" albo ".vlog").
+const char* logExtension(LogFormat format);
+// Zamienia nazwę polityki z configu (all|every|improvement) na LogPolicy; rzuca przy nieznanej nazwie.
+LogPolicy parseLogPolicy(const std::string& name);
+
+// Rekord logu o stałej szerokości: jedna linia cache.
+struct alignas(64) LogRecord {
+    double values[kMaxLogColumns];
+};
+
+// Bufor pierścieniowy jednego logu (jeden producent, jeden konsument - wątek zapisu).
+struct LogSink {
+    static constexpr std::size_t kCapacity = 8192;  // liczba rekordów (potęga dwójki)
+    static constexpr std::size_t kFlushThreshold = kCapacity / 4;  // co tyle wierszy producent budzi zapis
+
+    std::vector<LogRecord> ring = std::vector<LogRecord>(kCapacity);
+    alignas(64) std::atomic<std::size_t> head{0};   // następny zapis producenta
+    alignas(64) std::atomic<std::size_t> tail{0};   // następny odczyt wątku zapisu
+    alignas(64) std::atomic<bool> closing{false};   // producent skończył; dopisz resztę i zamknij
+    std::atomic<bool> done{false};                  // plik domknięty przez wątek zapisu
+    LogFormat format = LogFormat::Csv;
+    int columns = 0;
+    std::ofstream out;
+    std::vector<double> columnBlock;                // bufor transpozycji dla formatu binarnego
+};
+
+// Klasa CSVLogger otwiera plik i pozwala dopisać wiersze liczbowe. Opcjonalnie zbiera też
+// krzywą best runu (RunCurve) do agregacji między runami.
 class CSVLogger {
   public:
-    // Konstruktor otwierający plik i zapisujący opcjonalny nagłówek.
-    CSVLogger(const std::string& path, const std::string& header);
-    // Destruktor zamyka plik.
+    // Logger bez pliku (wiersze trafiają tylko do podpiętej krzywej).
+    CSVLogger() = default;
+    // Konstruktor otwierający plik i zapisujący nagłówek (nazwy kolumn rozdzielone przecinkami).
+    CSVLogger(const std::string& path, const std::string& header, LogFormat format = LogFormat::Csv);
+    // Destruktor czeka, aż wątek zapisu dopisze wszystkie wiersze i zamknie plik.
     ~CSVLogger();
-    // Dodaje jeden wiersz tekstu (już sformatowany CSV).
-    void logRow(const std::string& row);
+
+    CSVLogger(const CSVLogger&) = delete;
+    CSVLogger& operator=(const CSVLogger&) = delete;
+
+    // Dopisuje wiersz (krok, best, ...); liczba wartości musi odpowiadać nagłówkowi. Pierwsza
+    // kolumna (numer kroku) jest w CSV zapisywana jako liczba całkowita. W gorącej pętli tylko
+    // zapis do pamięci.
+    template <typename... Values>
+    void log(Values... values) {
+        static_assert(sizeof...(Values) >= 2 && sizeof...(Values) <= kMaxLogColumns,
+                      "wiersz logu: od 2 do kMaxLogColumns kolumn");
+        const double row[] = {static_cast<double>(values)...};
+        if (curve) curve->record(static_cast<long long>(row[0]), row[1]);
+        if (!sink) return;
+        if (policy != LogPolicy::All && !keepRow(row)) {
+            std::copy(row, row + sizeof...(Values), pending.values);
+            hasPending = true;
+            return;
+        }
+        push(row, sizeof...(Values));
+    }
+    // Ustawia politykę zapisu wierszy (every - co ile kroków dla LogPolicy::Every). Ostatni
+    // wiersz jest zawsze zapisywany przy zamknięciu logu.
+    void setPolicy(LogPolicy logPolicy, int every);
+    // Podpina krzywą runu (nullptr odpina); logger nie przejmuje własności.
+    void attachCurve(RunCurve* runCurve) { curve = runCurve; }
     // Sprawdza czy plik jest gotowy do zapisu.
-    bool ok() const;
+    bool ok() const { return sink != nullptr; }
+    // Ścieżka pliku logu.
+    const std::string& path() const { return filePath; }
+    // Format pliku logu.
+    LogFormat format() const { return fileFormat; }
+    // Polityka zapisu wierszy i krok dla LogPolicy::Every (do przeniesienia na logi pomocnicze).
+    LogPolicy rowPolicy() const { return policy; }
+    int rowEvery() const { return static_cast<int>(every); }
 
   private:
-    std::ofstream out;  // strumień wyjściowy
+    // Czy wiersz przechodzi przez politykę zapisu.
+    bool keepRow(const double* row) {
+        if (policy == LogPolicy::Every) return static_cast<long long>(row[0]) % every == 0;
+        if (row[1] < lastBest) {
+            lastBest = row[1];
+            return true;
+        }
+        return false;
+    }
+    // Kopiuje wiersz do bufora pierścieniowego.
+    void push(const double* row, int count) {
+        std::size_t slot = sink->head.load(std::memory_order_relaxed);
+        if (slot - sinkTail >= LogSink::kCapacity) waitForSpace(slot);
+        LogRecord& record = sink->ring[slot & (LogSink::kCapacity - 1)];
+        std::copy(row, row + count, record.values);
+        sink->head.store(slot + 1, std::memory_order_release);
+        hasPending = false;
+        if (slot + 1 == flushAt) requestFlush();
+    }
+    // Czeka na zwolnienie miejsca w pełnym buforze (wolna ścieżka).
+    void waitForSpace(std::size_t slot);
+    // Budzi wątek zapisu po kolejnych kFlushThreshold wierszach (wolna ścieżka).
+    void requestFlush();
+
+    std::shared_ptr<LogSink> sink;  // bufor współdzielony z wątkiem zapisu (null gdy plik się nie otworzył)
+    std::size_t sinkTail = 0;       // ostatnio odczytany tail (mniej odczytów atomowych)
+    std::size_t flushAt = LogSink::kFlushThreshold;  // head, przy którym obudzić wątek zapisu
+    std::string filePath;           // ścieżka pliku
+    LogFormat fileFormat = LogFormat::Csv;  // format pliku
+    LogPolicy policy = LogPolicy::All;
+    long long every = 1;            // krok dla LogPolicy::Every
+    double lastBest = std::numeric_limits<double>::infinity();  // dla LogPolicy::Improvement
+    LogRecord pending;              // ostatni pominięty wiersz (dopisywany przy zamknięciu)
+    bool hasPending = false;
+    RunCurve* curve = nullptr;      // krzywa runu do agregacji (opcjonalna)
 };
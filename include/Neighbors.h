@@ -0,0 +1,23 @@
+// Listy kandydatów: k najbliższych klientów każdego węzła, posortowane rosnąco po odległości.
+#pragma once
+
+#include "DistanceMatrix.h"
+
+// Domyślna długość list kandydatów budowanych przy wczytaniu instancji.
+constexpr int kDefaultCandidates = 16;
+
+// Listy zapisane płasko: dla węzła id kolejne k identyfikatorów klientów (bez depo i bez samego
+// węzła), od najbliższego; remisy rozstrzyga mniejszy id.
+class CandidateLists {
+  public:
+    // Długość każdej listy.
+    int k() const { return perNode; }
+    // Początek listy kandydatów węzła id.
+    const int* of(int id) const { return ids.data() + static_cast<std::size_t>(id) * perNode; }
+
+  private:
+    friend class CandidateListsBuilder;
+
+    int perNode = 0;
+    AlignedVector<int> ids;  // (dimension + 1) * k, wiersz 0 nieużywany
+};
@@ -0,0 +1,68 @@
+// Szybka ścieżka małych instancji: zbiór id (albo pozycji) w Words słowach 64-bitowych na stosie.
+// Test i wstawianie to operacje na bitach, przeglądanie elementów - ctz po kolejnych słowach,
+// a liczność - popcount.
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+template <int Words>
+class NodeBitset {
+  public:
+    static constexpr int kCapacity = 64 * Words;
+
+    bool test(int v) const { return (words[v >> 6] >> (v & 63)) & 1u; }
+    void set(int v) { words[v >> 6] |= std::uint64_t{1} << (v & 63); }
+    void reset(int v) { words[v >> 6] &= ~(std::uint64_t{1} << (v & 63)); }
+
+    bool empty() const {
+        std::uint64_t any = 0;
+        for (int w = 0; w < Words; ++w) any |= words[w];
+        return any == 0;
+    }
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < Words; ++w) total += __builtin_popcountll(words[w]);
+        return total;
+    }
+    // Najmniejsza wartość >= from spoza zbioru (kCapacity, gdy wszystkie do końca są w zbiorze).
+    int nextUnset(int from) const {
+        for (int w = from >> 6; w < Words; ++w) {
+            std::uint64_t free = ~words[w];
+            if (w == from >> 6) free &= ~std::uint64_t{0} << (from & 63);
+            if (free) return (w << 6) + __builtin_ctzll(free);
+        }
+        return kCapacity;
+    }
+    // Wywołuje fn dla elementów w kolejności rosnącej.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (int w = 0; w < Words; ++w) {
+            for (std::uint64_t bits = words[w]; bits; bits &= bits - 1) fn((w << 6) + __builtin_ctzll(bits));
+        }
+    }
+
+  private:
+    std::uint64_t words[Words] = {};
+};
+
+// Liczba słów zbioru dla wartości 0..maxValue: 1, 2 albo 4 (do 64/128/256 wartości); 0, gdy
+// instancja jest za duża na szybką ścieżkę.
+inline int smallPathWords(int maxValue) {
+    if (maxValue < 64) return 1;
+    if (maxValue < 128) return 2;
+    if (maxValue < 256) return 4;
+    return 0;
+}
+
+// Wywołuje fn(std::integral_constant<int, Words>{}) dla liczby słów dobranej do maxValue i zwraca
+// true; false (bez wywołania), gdy instancja jest za duża na szybką ścieżkę.
+template <typename Fn>
+bool dispatchSmallPath(int maxValue, Fn&& fn) {
+    switch (smallPathWords(maxValue)) {
+        case 1: fn(std::integral_constant<int, 1>{}); return true;
+        case 2: fn(std::integral_constant<int, 2>{}); return true;
+        case 4: fn(std::integral_constant<int, 4>{}); return true;
+        default: return false;
+    }
+}
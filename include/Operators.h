@@ -0,0 +1,96 @@
+// Operatory EA na permutacjach: krzyżowania w O(n) zapisujące dziecko do bufora wywołującego,
+// mutacje i 2-opt aktualizujące skrót permutacji (FitnessCache.h) oraz selekcja turniejowa.
+#pragma once
+
+#include "Population.h"
+#include "VRP.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Rodzaj krzyżowania EA.
+enum class CrossoverType {
+    Ordered,           // OX
+    PartiallyMapped,   // PMX
+    Cycle,             // CX
+    EdgeRecombination, // ERX
+    EdgeAssembly       // EAX-lite (jeden cykl AB + scalanie podcykli po listach kandydatów)
+};
+
+// Zamienia nazwę z konfiguracji (ox/pmx/cx/cycle/erx/eax) na CrossoverType; nieznana nazwa daje OX.
+CrossoverType parseCrossoverType(const std::string& name);
+
+// Rodzaj mutacji EA.
+enum class MutationType {
+    Swap,      // zamiana dwóch genów
+    Inversion  // odwrócenie podciągu
+};
+
+// Zamienia nazwę z konfiguracji (inversion/inv lub swap) na MutationType; nieznana nazwa daje Swap.
+MutationType parseMutationType(const std::string& name);
+
+// Bufory robocze krzyżowań (jeden na wątek). Znaczniki "użyty" są stemplowane numerem wywołania,
+// więc nie trzeba ich czyścić między krzyżowaniami.
+struct CrossoverWorkspace {
+    // valueRange - największa wartość genu + 1 (dla klientów: dimension + 1).
+    explicit CrossoverWorkspace(int valueRange);
+    // Nowy stempel; po przepełnieniu licznika czyści znaczniki.
+    std::uint32_t nextStamp();
+
+    std::vector<std::uint32_t> mark;   // stempel ostatniego użycia wartości
+    std::uint32_t stamp = 0;
+    std::vector<int> posInP1;          // pozycja wartości w p1 (wg wartości)
+    std::vector<int> posInP2;          // pozycja wartości w p2 (wg wartości)
+    // ERX (wg wartości).
+    std::vector<int> neighbors;        // do 4 pozostałych sąsiadów
+    std::vector<int> degree;           // liczba pozostałych sąsiadów
+    std::vector<int> pool;             // nieodwiedzone wartości (usuwanie przez zamianę z ostatnim)
+    std::vector<int> slot;             // pozycja wartości w pool
+    // EAX (wg węzła lokalnego = pozycji w p1).
+    std::vector<int> bNode, bPos;      // trasa p2 w węzłach lokalnych i pozycje w niej
+    std::vector<int> remA, remB;       // pozostałe (nie wspólne, nie użyte) krawędzie z p1 i p2, po 2
+    std::vector<int> leftA, leftB;     // indeks ścieżki, w którym węzeł opuszczono krawędzią A/B
+    std::vector<int> path;             // ścieżka budowanego cyklu AB
+    std::vector<int> adj;              // sąsiedzi w rozwiązaniu pośrednim, po 2
+    std::vector<int> subtour;          // numer podcyklu węzła
+    std::vector<int> nextMember;       // lista węzłów podcyklu
+    std::vector<int> head, tail, size; // początek/koniec listy i rozmiar podcyklu
+    std::vector<int> order;            // kolejność scalania podcykli
+};
+
+// OX, PMX i CX mają szybką ścieżkę małych instancji na NodeBitset (PMX/CX dla wartości < 256, OX dla
+// wartości < 64), wybieraną według rozmiaru workspace; wynik jest taki sam jak w wersji ogólnej.
+// OX: segment z p1, pozostałe geny w kolejności p2 (od pozycji za segmentem).
+void orderedCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws);
+// PMX: segment z p1, reszta z p2 z odwzorowaniem konfliktów przez segment.
+void pmxCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                  CrossoverWorkspace& ws);
+// CX: cykle pozycji brane na przemian z p1 i p2.
+void cycleCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                    CrossoverWorkspace& ws);
+// ERX: trasa budowana z krawędzi obu rodziców; następny jest sąsiad o najmniejszej liczbie
+// pozostałych sąsiadów (remis losowy), a gdy brak sąsiadów - losowy nieodwiedzony.
+void edgeRecombinationCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                                CrossoverWorkspace& ws);
+// EAX-lite: jeden losowy cykl AB (krawędzie na przemian z p1 i p2) nakładany na p1, powstałe
+// podcykle scalane najtańszą wymianą dwóch krawędzi wśród list kandydatów. Permutacje traktowane
+// jako cykle klientów (bez depo).
+void edgeAssemblyCrossover(const Problem& problem, const int* p1, const int* p2, int n,
+                           std::vector<int>& child, CrossoverWorkspace& ws);
+
+// Wywołuje krzyżowanie wybranego rodzaju.
+void crossover(CrossoverType type, const Problem& problem, const int* p1, const int* p2, int n,
+               std::vector<int>& child, CrossoverWorkspace& ws);
+
+// Mutacja swap z prawdopodobieństwem mutationRate. Aktualizuje skrót; zwraca true, jeśli zmieniła perm.
+bool mutateSwap(std::vector<int>& perm, std::uint64_t& hash, double mutationRate);
+// Mutacja inwersji: z prawdopodobieństwem mutationRate odwraca losowy podciąg. Aktualizuje skrót;
+// zwraca true, jeśli zmieniła perm.
+bool mutateInversion(std::vector<int>& perm, std::uint64_t& hash, double mutationRate);
+// Jedna losowa próba 2-opt na permutacji (stosowana, jeśli skraca krawędzie). Aktualizuje skrót;
+// zwraca true, jeśli zmieniła perm.
+bool twoOptOnce(std::vector<int>& perm, std::uint64_t& hash, const Problem& problem);
+// Selekcja turniejowa: indeks najlepszego z tourSize losowych osobników (czyta tylko tablicę kosztów).
+int tournamentSelect(const Population& pop, int tourSize);
@@ -0,0 +1,191 @@
+// Lekkie liczniki i stopery runu: czas ścienny, liczba ocen, podział czasu EA na fazy, akceptacja
+// SA na poziom temperatury, alokacje i opcjonalnie liczniki sprzętowe (perf_event_open).
+// Punkty pomiarowe w gorących pętlach (makra VRP_PHASE, VRP_SA_ACCEPTANCE, liczenie alokacji)
+// znikają przy kompilacji z VRP_PERF=0 (make PERF=0).
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifndef VRP_PERF
+#define VRP_PERF 1
+#endif
+
+// Fazy pokolenia EA mierzone osobno.
+enum class Phase { Selection, Crossover, Mutation, LocalSearch, Decode, Logging };
+constexpr int kPhaseCount = 6;
+// Nazwa fazy w raportach (selection, crossover, ...).
+const char* phaseName(Phase phase);
+
+// Wyniki pomiarów jednego runu.
+struct RunMetrics {
+    double wallMs = 0.0;
+    long long evaluations = 0;          // pełne oceny rozwiązań (dekodowanie lub krok SA; z Budget)
+    double timeToBestMs = 0.0;          // chwila znalezienia najlepszego rozwiązania runu
+    long long evaluationsToBest = 0;
+    const char* stopReason = "completed";  // powód zakończenia (stopReasonName)
+    long long steps = 0;                // wykonane kroki (iteracje, restarty, kroki SA, pokolenia)
+    long long allocations = 0;          // wywołania operator new
+    double phaseNs[kPhaseCount] = {};   // czas faz EA (suma po wątkach; fazy dzieci szacowane z próbki)
+    std::vector<double> saAcceptance;   // ułamek zaakceptowanych ruchów SA na kolejnych temperaturach
+    long long cycles = -1;              // liczniki sprzętowe wątku runu (-1 gdy niedostępne)
+    long long cacheMisses = -1;
+    // Stan próbkowania faz (PhaseSampler, PhaseRegion): dokąd trafiają pomiary ScopedPhase, czasy
+    // faz w próbce i łączny czas obszarów próbkowanych jeszcze nierozdzielony na fazy.
+    enum class PhaseMode { Direct, Skip, Sampled } phaseMode = PhaseMode::Direct;
+    unsigned sampleTick = 0;
+    double sampledNs[kPhaseCount] = {};
+    double sampledScopeNs = 0.0;
+
+    double evaluationsPerSecond() const { return wallMs > 0.0 ? evaluations / (wallMs * 1e-3) : 0.0; }
+    // Dodaje alokacje i czasy faz z pomiaru innego wątku (np. wątku roboczego EA).
+    void merge(const RunMetrics& other);
+    // Rozdziela łączny czas próbkowanych zasięgów na fazy proporcjonalnie do próbki.
+    void foldSamples();
+    // Zapisuje pomiary jako JSON (plik obok logu runu).
+    bool writeJson(const std::string& path, const std::string& algorithm, int run, double cost) const;
+};
+
+// Pomiary bieżącego wątku (nullptr poza ScopedRunMetrics).
+RunMetrics* currentMetrics();
+
+// Na czas życia obiektu kieruje pomiary bieżącego wątku do `metrics` (nullptr wyłącza), a przy końcu
+// dopisuje alokacje wątku i - dla hardware=true - liczniki sprzętowe. Nie mierzy czasu ściennego.
+class ScopedRunMetrics {
+  public:
+    explicit ScopedRunMetrics(RunMetrics* metrics, bool hardware = false);
+    ~ScopedRunMetrics();
+    ScopedRunMetrics(const ScopedRunMetrics&) = delete;
+    ScopedRunMetrics& operator=(const ScopedRunMetrics&) = delete;
+
+  private:
+    RunMetrics* metrics;
+    RunMetrics* previous;
+    long long allocationsAtStart;
+    int cycleCounter = -1;
+    int missCounter = -1;
+};
+
+// Pomiary zadania na wątku roboczym (fragment potomstwa EA, wyspa): zbierane lokalnie i dołączane
+// do `target` (pod blokadą) przy końcu zadania. Dla target == nullptr nic nie mierzy.
+class WorkerMetrics {
+  public:
+    WorkerMetrics(RunMetrics* target, std::mutex& mutex) : target(target), mutex(mutex) {
+        scope.emplace(target ? &local : nullptr);
+    }
+    ~WorkerMetrics() {
+        scope.reset();
+        if (!target) return;
+        local.foldSamples();
+        std::lock_guard<std::mutex> lock(mutex);
+        target->merge(local);
+    }
+    WorkerMetrics(const WorkerMetrics&) = delete;
+    WorkerMetrics& operator=(const WorkerMetrics&) = delete;
+
+  private:
+    RunMetrics* target;
+    std::mutex& mutex;
+    RunMetrics local;
+    std::optional<ScopedRunMetrics> scope;
+};
+
+// Liczba alokacji (operator new) wykonanych dotąd przez bieżący wątek (0 przy VRP_PERF=0 i pod
+// AddressSanitizerem).
+long long threadAllocations();
+
+// Koszt jednego odczytu steady_clock (kalibrowany przy starcie), odejmowany od czasów faz.
+double clockOverheadNs();
+
+// Stoper fazy EA: dolicza czas od konstrukcji do destrukcji do pomiarów wątku (lub do próbki PhaseSampler).
+class ScopedPhase {
+  public:
+    explicit ScopedPhase(Phase phase) : metrics(currentMetrics()), phase(phase) {
+        if (metrics && metrics->phaseMode != RunMetrics::PhaseMode::Skip) start = std::chrono::steady_clock::now();
+        else metrics = nullptr;
+    }
+    ~ScopedPhase() {
+        if (metrics) {
+            double elapsed =
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            double* sink = metrics->phaseMode == RunMetrics::PhaseMode::Sampled ? metrics->sampledNs : metrics->phaseNs;
+            sink[static_cast<int>(phase)] += std::max(0.0, elapsed - clockOverheadNs());
+        }
+    }
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+  private:
+    RunMetrics* metrics;
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Próbkowanie faz krótkich operacji (dziecko EA to setki ns, a odczyt zegara kilkadziesiąt):
+// w zasięgu PhaseSampler fazy są mierzone tylko co kSampling-te wywołanie. Czas całego obszaru
+// (PhaseRegion, np. pętli potomstwa) jest mierzony zawsze, a foldSamples dzieli go na fazy
+// w proporcjach z próbki.
+class PhaseSampler {
+  public:
+    static constexpr unsigned kSampling = 64;
+    PhaseSampler() : metrics(currentMetrics()) {
+        if (metrics) {
+            metrics->phaseMode = ++metrics->sampleTick % kSampling == 0 ? RunMetrics::PhaseMode::Sampled
+                                                                        : RunMetrics::PhaseMode::Skip;
+        }
+    }
+    ~PhaseSampler() {
+        if (metrics) metrics->phaseMode = RunMetrics::PhaseMode::Direct;
+    }
+    PhaseSampler(const PhaseSampler&) = delete;
+    PhaseSampler& operator=(const PhaseSampler&) = delete;
+
+  private:
+    RunMetrics* metrics;
+};
+
+// Obszar złożony z wywołań objętych PhaseSampler: jego czas trafia do sampledScopeNs.
+class PhaseRegion {
+  public:
+    PhaseRegion() : metrics(currentMetrics()) {
+        if (metrics) start = std::chrono::steady_clock::now();
+    }
+    ~PhaseRegion() {
+        if (metrics) {
+            metrics->sampledScopeNs +=
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    PhaseRegion(const PhaseRegion&) = delete;
+    PhaseRegion& operator=(const PhaseRegion&) = delete;
+
+  private:
+    RunMetrics* metrics;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define VRP_PERF_CONCAT_(a, b) a##b
+#define VRP_PERF_CONCAT(a, b) VRP_PERF_CONCAT_(a, b)
+#if VRP_PERF
+// Mierzy czas do końca bloku jako fazę Phase::name.
+#define VRP_PHASE(name) ScopedPhase VRP_PERF_CONCAT(vrpPhase, __LINE__)(Phase::name)
+// Do końca bloku fazy są mierzone próbkowo (PhaseSampler).
+#define VRP_SAMPLE_PHASES() PhaseSampler VRP_PERF_CONCAT(vrpSampler, __LINE__)
+// Czas do końca bloku jest rozdzielany na fazy próbkowane wewnątrz (PhaseRegion).
+#define VRP_PHASE_REGION() PhaseRegion VRP_PERF_CONCAT(vrpRegion, __LINE__)
+// Zapisuje akceptację SA dla zakończonego poziomu temperatury.
+#define VRP_SA_ACCEPTANCE(rate) \
+    do { \
+        if (RunMetrics* vrpMetrics = currentMetrics()) vrpMetrics->saAcceptance.push_back(rate); \
+    } while (0)
+#else
+#define VRP_PHASE(name) ((void)0)
+#define VRP_SAMPLE_PHASES() ((void)0)
+#define VRP_PHASE_REGION() ((void)0)
+#define VRP_SA_ACCEPTANCE(rate) ((void)0)
+#endif
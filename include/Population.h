@@ -0,0 +1,55 @@
+// Populacja EA w jednym ciągłym bloku: macierz (osobniki x geny) oraz równoległe tablice kosztów
+// i skrótów permutacji (FitnessCache.h).
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Population {
+  public:
+    Population() = default;
+    // Alokuje miejsce na `individuals` permutacji długości `genes` (jedyna alokacja populacji).
+    Population(int individuals, int genes)
+        : count(individuals), length(genes), matrix(static_cast<std::size_t>(individuals) * genes),
+          costs(individuals, 0.0), hashes(individuals, 0) {}
+
+    int size() const { return count; }
+    int genes() const { return length; }
+
+    // Wiersz (permutacja) osobnika i.
+    int* row(int i) { return matrix.data() + static_cast<std::size_t>(i) * length; }
+    const int* row(int i) const { return matrix.data() + static_cast<std::size_t>(i) * length; }
+    double& cost(int i) { return costs[i]; }
+    double cost(int i) const { return costs[i]; }
+    std::uint64_t hash(int i) const { return hashes[i]; }
+
+    // Zapisuje permutację, koszt i skrót do wiersza i.
+    void assign(int i, const int* perm, double value, std::uint64_t key) {
+        std::copy(perm, perm + length, row(i));
+        costs[i] = value;
+        hashes[i] = key;
+    }
+    // Kopiuje osobnika srcRow z innej populacji (tych samych wymiarów) do wiersza dst.
+    void copyFrom(int dst, const Population& src, int srcRow) {
+        assign(dst, src.row(srcRow), src.costs[srcRow], src.hashes[srcRow]);
+    }
+
+    // Wymiana buforów (podwójne buforowanie pokoleń).
+    void swap(Population& other) {
+        std::swap(count, other.count);
+        std::swap(length, other.length);
+        matrix.swap(other.matrix);
+        costs.swap(other.costs);
+        hashes.swap(other.hashes);
+    }
+
+  private:
+    int count = 0;
+    int length = 0;
+    std::vector<int> matrix;     // wiersz i zaczyna się od i * length
+    std::vector<double> costs;
+    std::vector<std::uint64_t> hashes;
+};
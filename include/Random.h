@@ -1,13 +1,94 @@
-// Pomocnicze funkcje losowe oparte o wspólny generator.
+// Podsystem liczb losowych: szybki generator xoshiro256** ze stanem lokalnym dla wątku
+// i niezależnymi strumieniami wyprowadzanymi z (seed, instancja, algorytm, run).
 #pragma once
 
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
-// Zwraca referencję do globalnego generatora.
-std::mt19937& globalRng();
+// Generator xoshiro256** (Blackman, Vigna); stan 256 bitów, okres 2^256 - 1.
+class Xoshiro256 {
+  public:
+    using result_type = std::uint64_t;
+
+    // Ustawia stan z 64-bitowego ziarna przez splitmix64.
+    explicit Xoshiro256(std::uint64_t seed = 0) { reseed(seed); }
+    void reseed(std::uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+  private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    std::uint64_t state[4];
+};
+
+// Krok generatora splitmix64 (używany do rozprowadzania ziaren).
+std::uint64_t splitMix64(std::uint64_t& state);
+
+// Wyznacza ziarno niezależnego strumienia dla danego uruchomienia.
+std::uint64_t deriveStreamSeed(std::uint64_t seed, const std::string& instance, const std::string& algorithm,
+                               std::uint64_t run);
+
+// Wyznacza ziarno podstrumienia (np. pokolenie i fragment populacji) z ziarna bazowego.
+std::uint64_t deriveSubstreamSeed(std::uint64_t base, std::uint64_t major, std::uint64_t minor);
+
+// Zwraca ziarno z std::random_device (gdy użytkownik nie podał seed=).
+std::uint64_t entropySeed();
+
+// Zwraca generator bieżącego wątku.
+Xoshiro256& threadRng();
+
+// Na czas życia obiektu ustawia generator wątku na podane ziarno, potem przywraca poprzedni stan.
+class ScopedRngStream {
+  public:
+    explicit ScopedRngStream(std::uint64_t seed);
+    ~ScopedRngStream();
+    ScopedRngStream(const ScopedRngStream&) = delete;
+    ScopedRngStream& operator=(const ScopedRngStream&) = delete;
+
+  private:
+    Xoshiro256 saved;  // stan generatora sprzed zakresu
+};
+
+// Losuje liczbę z zakresu [0, range) metodą Lemire'a (mnożenie zamiast dzielenia); range > 0.
+inline std::uint32_t randBounded(std::uint32_t range) {
+    std::uint64_t m = (threadRng()() >> 32) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+    if (low < range) {
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = (threadRng()() >> 32) * range;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+    return static_cast<std::uint32_t>(m >> 32);
+}
 
 // Losuje liczbę całkowitą z zakresu [min, max].
-int randInt(int min, int max);
+inline int randInt(int min, int max) {
+    return min + static_cast<int>(randBounded(static_cast<std::uint32_t>(max - min) + 1u));
+}
+
+// Losuje liczbę zmiennoprzecinkową z zakresu [0, 1).
+inline double randUnit() {
+    return static_cast<double>(threadRng()() >> 11) * 0x1.0p-53;
+}
+
+// Wypełnia bufor kolejnymi 64-bitowymi wartościami generatora wątku.
+void fillRandom(std::uint64_t* out, std::size_t count);
 
-// Losuje liczbę zmiennoprzecinkową z zakresu [0, 1].
-double randUnit();
+// Tasuje tablicę (Fisher-Yates); liczby losowane są paczkami, po dwie 32-bitowe z jednego słowa.
+void shuffleInPlace(int* data, std::size_t count);
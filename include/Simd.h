@@ -0,0 +1,11 @@
+// Poziom instrukcji wektorowych dostępny na bieżącym procesorze (CPUID), wspólny dla jąder SIMD.
+#pragma once
+
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+// Najwyższy poziom obsługiwany przez procesor i system (sprawdzany raz).
+SimdLevel detectedSimd();
+// Nazwa poziomu w raportach (scalar, avx2, avx512).
+const char* simdLevelName(SimdLevel level);
+// Podany poziom ograniczony do obsługiwanego (do wymuszania niższych poziomów w benchmarkach).
+SimdLevel clampSimd(SimdLevel level);
@@ -0,0 +1,14 @@
+// Optymalny podział permutacji na trasy: Split (Prins 2004), wariant liniowy z kolejką dwustronną (Vidal 2016).
+#pragma once
+
+#include "VRP.h"
+
+#include <vector>
+
+// Koszt optymalnego podziału permutacji na trasy. maxRoutes > 0 ogranicza liczbę tras
+// (wariant O(n * maxRoutes)); gdy takiego podziału nie ma, używany jest podział bez limitu.
+// Korzysta z buforów lokalnych dla wątku, więc po rozgrzaniu nie alokuje pamięci.
+double splitCost(const Problem& problem, const std::vector<int>& perm, int maxRoutes);
+
+// Jak splitCost, ale zwraca Solution z indeksami początków tras.
+Solution splitDecode(const Problem& problem, const std::vector<int>& perm, int maxRoutes);
@@ -13,3 +13,34 @@ struct RunStats {
 
 // Funkcja liczy statystyki dla podanego wektora wyników (niższy = lepszy).
 RunStats computeStats(const std::vector<double>& values);
+
+// Statystyki strumieniowe (Welford): średnia i wariancja bez przechowywania wartości, plus min/max.
+struct RunningStats {
+    long long count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;    // suma kwadratów odchyleń od średniej
+    double min = 0.0;
+    double max = 0.0;
+
+    // Dodaje wartość do statystyk.
+    void add(double value);
+    // Odchylenie standardowe populacji (jak w computeStats).
+    double stddev() const;
+};
+
+// Estymator kwantyla P² (Jain, Chlamtac): 5 znaczników, stała pamięć, bez przechowywania próbki.
+class P2Quantile {
+  public:
+    // p - rząd kwantyla z przedziału (0, 1), np. 0.5 dla mediany.
+    explicit P2Quantile(double p);
+    // Dodaje obserwację.
+    void add(double value);
+    // Bieżące oszacowanie kwantyla (dokładne dla mniej niż 5 obserwacji).
+    double value() const;
+
+  private:
+    double p;
+    int count = 0;
+    double heights[5] = {};  // wysokości znaczników
+    int positions[5] = {};   // pozycje znaczników (od 0)
+};
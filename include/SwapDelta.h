@@ -0,0 +1,45 @@
+// Przyrostowa ocena ruchów swap dla dekodera zachłannego (używana przez SA).
+#pragma once
+
+#include "VRP.h"
+
+#include <vector>
+
+// Trzyma permutację wraz z tablicami prefiksowymi ładunku i kosztu podziału na trasy.
+// Ruch swap jest stosowany w miejscu, a koszt liczony tylko od pierwszej zmienionej pozycji,
+// aż do miejsca, w którym podział na trasy zsynchronizuje się ze starym.
+// Dla dekoderów innych niż Greedy ruch jest oceniany pełnym decodeCost (bez tablic prefiksowych).
+class SwapDeltaEvaluator {
+  public:
+    // Buduje stan dla podanej permutacji (jedna pełna ewaluacja).
+    SwapDeltaEvaluator(const Problem& problem, std::vector<int> permutation,
+                       DecoderType decoder = DecoderType::Greedy);
+
+    // Koszt bieżącej permutacji.
+    double cost() const { return total; }
+    // Bieżąca permutacja (po zastosowanym, ale jeszcze nie zatwierdzonym ruchu zawiera zamianę).
+    const std::vector<int>& permutation() const { return perm; }
+
+    // Zamienia pozycje i, j w miejscu i zwraca koszt po zamianie; bez alokacji.
+    // Po wywołaniu trzeba wywołać commit() albo undo().
+    double applySwap(int i, int j);
+    // Zatwierdza ostatni ruch i aktualizuje tablice prefiksowe.
+    void commit();
+    // Cofa ostatni ruch.
+    void undo();
+
+  private:
+    // Przelicza tablice prefiksowe od pozycji start do końca.
+    void rebuildFrom(int start);
+
+    const Problem& problem;
+    DecoderType decoder;              // sposób podziału na trasy
+    std::vector<int> perm;            // bieżąca permutacja klientów
+    std::vector<int> load;            // ładunek trasy po obsłużeniu pozycji p
+    std::vector<double> prefixCost;   // koszt od początku do przyjazdu na pozycję p
+    std::vector<char> routeStart;     // czy na pozycji p zaczyna się trasa
+    double total = 0.0;               // pełny koszt bieżącej permutacji
+    int pendingFirst = 0;             // mniejsza pozycja ostatniego ruchu
+    int pendingSecond = 0;            // większa pozycja ostatniego ruchu
+    double pendingCost = 0.0;         // koszt po ostatnim ruchu
+};
@@ -0,0 +1,86 @@
+// Pula wątków z kolejką zadań na wątek i podkradaniem pracy (work stealing).
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Klasa ThreadPool rozdziela zadania po kolejkach wątków; bezczynny wątek podkrada
+// zadania z końca cudzych kolejek, więc nierówne czasy zadań są równoważone dynamicznie.
+class ThreadPool {
+  public:
+    // Tworzy pulę z podaną liczbą wątków (0 oznacza liczbę rdzeni). Dla 1 wątku zadania
+    // wykonywane są sekwencyjnie w wątku wywołującym wait(), w kolejności zgłoszenia.
+    explicit ThreadPool(int threads);
+    // Czeka na zakończenie zadań i zatrzymuje wątki.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Dodaje zadanie; kolejne zadania trafiają do kolejek wątków po kolei (round-robin).
+    void submit(std::function<void()> task);
+    // Blokuje do zakończenia wszystkich zgłoszonych zadań; przekazuje dalej pierwszy wyjątek z zadania.
+    void wait();
+    // Liczba wątków roboczych (co najmniej 1).
+    int size() const { return threadCount; }
+
+    // Wykonuje fn(i) dla i = 0..count-1 jako osobne zadania i czeka na ich zakończenie.
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+    // Indeks wątku puli wykonującego bieżące zadanie (0..size()-1); służy do wyboru buforów roboczych.
+    static int workerIndex();
+
+  private:
+    // Kolejka zadań jednego wątku.
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Pętla wątku roboczego.
+    void workerLoop(int index);
+    // Pobiera zadanie z czoła własnej kolejki albo podkrada z końca innej.
+    bool takeTask(int index, std::function<void()>& task);
+    // Wykonuje zadanie i aktualizuje licznik oczekujących.
+    void runTask(std::function<void()>& task);
+
+    int threadCount;                                    // liczba wątków logicznych
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // kolejki per wątek
+    std::vector<std::thread> workers;                   // wątki robocze (puste dla 1 wątku)
+    std::atomic<size_t> pending{0};                     // zadania zgłoszone, a niezakończone
+    size_t nextQueue = 0;                               // kolejka dla następnego submit
+    std::mutex stateMutex;                              // chroni uśpienie, stop i wyjątek
+    std::condition_variable workAvailable;              // budzi wątki po submit
+    std::condition_variable allDone;                    // budzi wait() po ostatnim zadaniu
+    bool stopping = false;
+    std::exception_ptr firstError;
+};
+
+// Bariera cykliczna dla `parties` wątków (np. rund wymiany replik). Ostatni przybyły wykonuje onLast
+// pod blokadą bariery - widzi zapisy wszystkich uczestników, a oni widzą jego zapisy po zwolnieniu.
+class Barrier {
+  public:
+    explicit Barrier(int parties) : parties(parties) {}
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    // Czeka na pozostałych uczestników; ostatni wykonuje onLast, zanim zwolni wszystkich. Wyjątek z onLast
+    // także zwalnia czekających i trafia do ostatniego uczestnika.
+    void arriveAndWait(const std::function<void()>& onLast);
+
+  private:
+    std::mutex mutex;
+    std::condition_variable released;
+    int parties;
+    int waiting = 0;                    // przybyli w bieżącej rundzie
+    unsigned long long generation = 0;  // numer rundy (zmiana zwalnia czekających)
+};
@@ -1,6 +1,9 @@
 // Definicje struktur reprezentujących problem cVRP i funkcje pomocnicze.
 #pragma once
 
+#include "DistanceOracle.h"
+#include "Neighbors.h"
+
 #include <string>
 #include <vector>
 // Pojedynczy węzeł (lokalizacja) z zapotrzebowaniem i współrzędnymi.
@@ -11,23 +14,68 @@ struct Node {
     int demand;      // zapotrzebowanie
 };
 
+// Sposób liczenia odległości (EDGE_WEIGHT_TYPE).
+enum class EdgeWeightType {
+    Euc2D,     // euklidesowa zaokrąglona do najbliższej liczby całkowitej
+    Ceil2D,    // euklidesowa zaokrąglona w górę
+    Explicit   // macierz podana w EDGE_WEIGHT_SECTION
+};
+
 // Struktura opisująca cały problem cVRP.
 struct Problem {
+    std::string name;                   // nazwa instancji (NAME lub nazwa pliku)
+    int vehicles;                       // liczba pojazdów z nazwy (np. A-n32-k5 -> 5), 0 gdy brak
     int dimension;                      // liczba węzłów
     int capacity;                       // pojemność pojazdu
     int depotId;                        // identyfikator depo (zwykle 1)
     std::vector<Node> nodes;            // lista węzłów
-    std::vector<std::vector<double>> distances;  // macierz odległości
+    DistanceOracle distances;           // odległości wg id węzłów (macierz albo liczone na żądanie)
+    AlignedVector<int> demands;         // zapotrzebowania wg id (SoA, indeks 0 nieużywany)
+    AlignedVector<double> xs;           // współrzędne X wg id (SoA)
+    AlignedVector<double> ys;           // współrzędne Y wg id (SoA)
+    CandidateLists candidates;          // k najbliższych klientów każdego węzła
+    EdgeWeightType edgeWeightType = EdgeWeightType::Euc2D;
+    double parseMs = 0.0;               // czas wczytania pliku (bez macierzy dla *_2D i list kandydatów)
 };
 
-// Rozwiązanie składa się z tras oraz kosztu.
+// Rozwiązanie to permutacja klientów z indeksami początków tras oraz koszt.
 struct Solution {
-    std::vector<std::vector<int>> routes;  // każda trasa to lista węzłów bez depo
+    std::vector<int> perm;                 // kolejność odwiedzin klientów (bez depo)
+    std::vector<int> routeStarts;          // indeksy w perm, od których zaczynają się kolejne trasy
     double cost;                           // łączny koszt tras
 };
 
-// Funkcja wczytuje plik VRP i buduje strukturę Problem.
-Problem parseVRP(const std::string& path);
+// Sposób podziału permutacji (giant tour) na trasy.
+enum class DecoderType {
+    Greedy,        // nowa trasa, gdy kolejny klient przekroczyłby pojemność
+    Split,         // optymalny podział (Split Prinsa, liniowy wariant z kolejką dwustronną)
+    SplitBounded   // optymalny podział z limitem liczby tras równym Problem::vehicles
+};
+
+// Zamienia nazwę dekodera z konfiguracji (greedy/split) na DecoderType; nieznana nazwa daje Greedy.
+DecoderType parseDecoderType(const std::string& name, bool fleetLimit);
+
+// Funkcja wczytuje plik VRP i buduje strukturę Problem razem z odległościami (tryb wg `distances`)
+// i listami kandydatów.
+Problem parseVRP(const std::string& path, const DistanceSettings& distances = {});
+
+// Funkcja wczytuje plik VRPLIB (EDGE_WEIGHT_TYPE EUC_2D, CEIL_2D lub EXPLICIT z macierzą FULL_MATRIX,
+// LOWER_ROW, LOWER_DIAG_ROW, UPPER_ROW, UPPER_DIAG_ROW) do tablic SoA. Dla EXPLICIT wypełnia też
+// macierz odległości; dla *_2D macierz buduje dopiero buildDistanceMatrix. Sprawdza zakres i
+// kompletność id w sekcjach, błędy zgłasza std::runtime_error z numerem linii.
+Problem readVrplib(const std::string& path);
+
+// Odczytuje liczbę pojazdów z nazwy w stylu "A-n32-k5" (0 gdy brak).
+int vehiclesFromName(const std::string& name);
+
+// Funkcja buduje macierz odległości z tablic współrzędnych xs/ys (EUC_2D zaokrąglone, CEIL_2D
+// w górę) albo, gdy settings wskazują tryb na żądanie, przekazuje współrzędne do DistanceOracle;
+// dla EXPLICIT zostawia macierz wczytaną z pliku.
+void buildDistanceMatrix(Problem& problem, const DistanceSettings& settings = {});
+
+// Funkcja buduje listy k najbliższych klientów (siatka jednorodna, O(n log n); dla EXPLICIT
+// z wierszy macierzy); parseVRP buduje je z k = kDefaultCandidates.
+void buildCandidateLists(Problem& problem, int k);
 
 // Funkcja wczytuje linię "Cost xx" z pliku optimum, zwraca -1 jeśli brak.
 double readOptimalCost(const std::string& path);
@@ -36,7 +84,21 @@ double readOptimalCost(const std::string& path);
 double evaluateSolution(const Problem& problem, const Solution& solution);
 
 // Funkcja przelicza permutację klientów na trasy zgodnie z ograniczeniami pojemności.
-Solution decodePermutation(const Problem& problem, const std::vector<int>& permutation);
+Solution decodePermutation(const Problem& problem, const std::vector<int>& permutation,
+                           DecoderType decoder = DecoderType::Greedy);
+
+// Funkcja liczy sam koszt zdekodowanej permutacji w jednym przebiegu, bez alokacji.
+double decodeCost(const Problem& problem, const std::vector<int>& permutation,
+                  DecoderType decoder = DecoderType::Greedy);
+
+// Koszt dekodera greedy dla permutacji perm[0..length) (decodeCost dla DecoderType::Greedy).
+double greedyCost(const Problem& problem, const int* perm, int length);
+
+// Funkcja buduje zagnieżdżone listy tras (bez depo) - tylko do raportowania wyniku.
+std::vector<std::vector<int>> expandRoutes(const Solution& solution);
 
 // Funkcja generuje losową permutację klientów (bez depo).
 std::vector<int> randomPermutation(const Problem& problem);
+
+// Funkcja wypełnia podany bufor losową permutacją klientów (bez ponownej alokacji).
+void fillRandomPermutation(const Problem& problem, std::vector<int>& perm);
@@ -1,5 +1,5 @@
 #!/usr/bin/env python3
-# Skrypt rysuje przebiegi z logów CSV zapisanych przez program.
+# Skrypt rysuje przebiegi z logów CSV lub binarnych (.vlog, log_format=binary) zapisanych przez program.
 LOG_DIR = "logs_baseline"      # katalog z logami (per instancja podkatalog)
 OUTPUT_DIR = "plots_baseline"  # katalog na wykresy
 RUN_PICK_STRATEGY = "middle"   # "middle" wybiera środkowy run, można ustawić "first"/"last"/indeks int
@@ -7,7 +7,10 @@ RUN_PICK_STRATEGY = "middle"   # "middle" wybiera środkowy run, można ustawić
 import os
 import glob
 import math
+import re
 import csv
+import struct
+from array import array
 from typing import List, Dict, Union
 
 import matplotlib.pyplot as plt
@@ -36,8 +39,32 @@ def pick_run(files: List[str], strategy: str) -> str:
     return sorted(files)[0]
 
 
+def read_vlog(path: str) -> Dict[str, List[float]]:
+    # Czyta binarny log kolumnowy (.vlog): nagłówek, potem bloki kolumn float64.
+    data: Dict[str, List[float]] = {}
+    with open(path, "rb") as f:
+        if f.read(8) != b"VRPLOG1\n":
+            raise ValueError(f"{path}: to nie jest plik .vlog")
+        columns, header_len = struct.unpack("<II", f.read(8))
+        names = f.read(header_len).decode("utf-8").split(",")
+        for name in names:
+            data[name] = []
+        while True:
+            raw = f.read(4)
+            if len(raw) < 4:
+                break
+            (rows,) = struct.unpack("<I", raw)
+            block = array("d")
+            block.frombytes(f.read(8 * rows * columns))
+            for c, name in enumerate(names):
+                data[name].extend(block[c * rows:(c + 1) * rows])
+    return data
+
+
 def read_series(path: str) -> Dict[str, List[float]]:
-    # Czyta kolumny numeryczne z CSV do słowników list.
+    # Czyta kolumny numeryczne z CSV (albo .vlog) do słowników list.
+    if path.endswith(".vlog"):
+        return read_vlog(path)
     data: Dict[str, List[float]] = {}
     with open(path, newline="") as f:
         reader = csv.DictReader(f)
@@ -56,11 +83,17 @@ def _limit_series(alg_name: str, data: Dict[str, List[float]]) -> Dict[str, List
     return data
 
 
+def _steps(data: Dict[str, List[float]]) -> List[float]:
+    # Oś X przebiegu: pierwsza kolumna logu (krok/iteracja/pokolenie). Przy log_policy=every|improvement
+    # wiersze są przerzedzone, więc numer wiersza nie jest numerem kroku.
+    return next(iter(data.values()), [])
+
+
 def plot_single(instance: str, alg_name: str, data: Dict[str, List[float]], optimal: float, out_path: str) -> None:
     # Rysuje wykres best/current/avg/worst dla jednego algorytmu.
     data = _limit_series(alg_name, data)
     plt.figure(figsize=(10, 5.5), dpi=150)
-    x = list(range(len(next(iter(data.values()), []))))
+    x = _steps(data)
     best_val = None
     for key in ["best", "current", "avg", "worst"]:
         if key in data:
@@ -91,14 +124,14 @@ def plot_combined(instance: str, series_map: Dict[str, Dict[str, List[float]]],
     plt.figure(figsize=(10, 5.5), dpi=150)
     colors = {"random": "tab:blue", "greedy": "tab:orange", "sa": "tab:purple", "ea": "tab:red"}
     
-    # Znajdź maksymalną długość serii (pomijając SA, bo ma za dużo stepów).
-    max_length = 0
+    # Znajdź największy krok serii (pomijając SA, bo ma za dużo stepów).
+    max_step = 0.0
     for alg, data in series_map.items():
         if alg == "sa":
             continue
         data_limited = _limit_series(alg, data)
         if "best" in data_limited and data_limited["best"]:
-            max_length = max(max_length, len(data_limited["best"]))
+            max_step = max(max_step, _steps(data_limited)[-1])
     
     for alg, data in series_map.items():
         data_limited = _limit_series(alg, data)
@@ -116,23 +149,46 @@ def plot_combined(instance: str, series_map: Dict[str, Dict[str, List[float]]],
             plt.axhline(final_best, color=colors.get(alg, None), linestyle="--",
                         label=label_text)
         else:
-            x = list(range(len(best_series)))
+            x = _steps(data_limited)
             # Rysuj ciągłą linię dla oryginalnej serii.
             plt.plot(x, best_series, label=label_text, color=colors.get(alg, None))
             
-            # Jeśli seria jest krótsza niż max, dorysuj przerywaną linię na końcowej wartości.
-            if len(best_series) < max_length:
+            # Jeśli seria kończy się przed największym krokiem, dorysuj przerywaną linię na końcowej wartości.
+            if x[-1] < max_step:
                 final_value = best_series[-1]
-                x_extend = list(range(len(best_series) - 1, max_length))
-                y_extend = [final_value] * len(x_extend)
-                plt.plot(x_extend, y_extend, linestyle="--", color=colors.get(alg, None), alpha=0.6)
+                plt.plot([x[-1], max_step], [final_value, final_value], linestyle="--",
+                         color=colors.get(alg, None), alpha=0.6)
     
     if optimal > 0:
         plt.axhline(optimal, color="green", linestyle="--", label=f"optimal {optimal}")
     plt.title(f"{instance} - Przebieg najlepszych rozwiązań (pojedyncze uruchomienie)")
     plt.xlabel("step")
     plt.ylabel("cost")
-    plt.xlim(0, max_length)
+    plt.xlim(0, max_step)
+    plt.legend()
+    plt.tight_layout()
+    plt.savefig(out_path)
+    plt.close()
+
+
+def plot_aggregate(instance: str, alg_name: str, data: Dict[str, List[float]], optimal: float, out_path: str) -> None:
+    # Rysuje krzywą zbiorczą best z wielu runów (log_mode=aggregate): mediana, pasmo q10-q90, min/max.
+    if "step" not in data or not data["step"]:
+        return
+    plt.figure(figsize=(10, 5.5), dpi=150)
+    x = data["step"]
+    runs = int(max(data.get("runs", [0])))
+    plt.fill_between(x, data["q10"], data["q90"], alpha=0.25, label="q10-q90")
+    plt.plot(x, data["median"], label="median")
+    plt.plot(x, data["mean"], linestyle=":", label="mean")
+    plt.plot(x, data["min"], linestyle="--", linewidth=0.8, label="min")
+    plt.plot(x, data["max"], linestyle="--", linewidth=0.8, label="max")
+    if optimal > 0:
+        plt.axhline(optimal, color="green", linestyle="--", label=f"optimal {optimal}")
+    plt.title(f"{instance} - {alg_name}: best z {runs} uruchomień")
+    plt.xlabel("step" if alg_name != "ea" else "generation")
+    plt.ylabel("cost")
+    plt.xlim(left=0)
     plt.legend()
     plt.tight_layout()
     plt.savefig(out_path)
@@ -223,10 +279,10 @@ def main(log_dir: str = LOG_DIR, out_dir: str = OUTPUT_DIR, run_pick_strategy: s
         optimal_val = optimal_map.get(inst_dir, -1.0)
         # Zbieramy pliki run per alg.
         alg_patterns = {
-            "random": os.path.join(full_inst_dir, "random_run_*.csv"),
-            "greedy": os.path.join(full_inst_dir, "greedy_run_*.csv"),
-            "sa": os.path.join(full_inst_dir, "sa_run_*.csv"),
-            "ea": os.path.join(full_inst_dir, "ea_run_*.csv"),
+            "random": os.path.join(full_inst_dir, "random_run_*"),
+            "greedy": os.path.join(full_inst_dir, "greedy_run_*"),
+            "sa": os.path.join(full_inst_dir, "sa_run_*"),
+            "ea": os.path.join(full_inst_dir, "ea_run_*"),
         }
         series_for_combined: Dict[str, Dict[str, List[float]]] = {}
         # Wyjściowy katalog dla instancji.
@@ -234,7 +290,15 @@ def main(log_dir: str = LOG_DIR, out_dir: str = OUTPUT_DIR, run_pick_strategy: s
         ensure_dir(inst_out_dir)
         # Przechodzimy po algorytmach.
         for alg, pattern in alg_patterns.items():
-            files = glob.glob(pattern)
+            # Krzywa zbiorcza z trybu log_mode=aggregate (jeden plik zamiast logów wszystkich runów).
+            curve_path = os.path.join(full_inst_dir, f"{alg}_curve.csv")
+            if os.path.isfile(curve_path):
+                aggregate_path = os.path.join(inst_out_dir, f"{alg}_aggregate.png")
+                plot_aggregate(inst_dir, alg, read_series(curve_path), optimal_val, aggregate_path)
+            # Tylko logi runów (<alg>_run_<n>.csv lub .vlog); logi boczne wysp EA (_island_), replik SA
+            # (_replica_) i wymian (_exchanges) pomijamy.
+            run_name = re.compile(rf"{alg}_run_\d+\.(csv|vlog)")
+            files = [p for p in glob.glob(pattern) if run_name.fullmatch(os.path.basename(p))]
             run_path = pick_run(files, run_pick_strategy)
             if not run_path:
                 continue
@@ -1,16 +1,31 @@
 // Implementacje algorytmów: losowy, zachłanny, SA, EA.
 #include "Algorithms.h"
 
+#include "BatchEval.h"
+#include "EaPolicies.h"
+#include "FitnessCache.h"
+#include "LocalSearch.h"
+#include "NodeBitset.h"
+#include "Operators.h"
+#include "Perf.h"
+#include "Population.h"
 #include "Random.h"
 #include "Stats.h"
+#include "SwapDelta.h"
+#include "ThreadPool.h"
 #include "VRP.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <exception>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_set>
+#include <utility>
 
 static std::string toLowerCopy(std::string text) {
     std::transform(text.begin(), text.end(), text.begin(),
@@ -18,365 +33,1006 @@ static std::string toLowerCopy(std::string text) {
     return text;
 }
 
-// Reprezentacja osobnika dla EA.
+// Osobnik EA poza macierzą populacji (najlepszy znaleziony, migranci).
 struct Individual {
     std::vector<int> perm;
     double cost;
 };
 
-// Buduje permutację metodą najbliższego sąsiada startując z podanego węzła.
-static std::vector<int> buildGreedyPermutation(const Problem& problem, int startId) {
-    std::unordered_set<int> unvisited;
+// Bufory robocze jednego wątku EA: dziecko budowane jest tutaj, a potem kopiowane do wiersza następnego pokolenia.
+struct EaScratch {
+    std::vector<int> child;
+    CrossoverWorkspace crossoverWork{0};       // bufory krzyżowania (rozmiar ustawia EvolutionRun)
+    std::unique_ptr<LocalSearch> localSearch;  // silnik LS (tylko dla ea_local_search=routes)
+    Solution routes;                           // zdekodowane dziecko poprawiane przez LS
+    // Najtańsze trasy dziecka, którego kosztem jest koszt tras LS (dekoder ich nie odtwarza).
+    Solution bestRoutes{{}, {}, std::numeric_limits<double>::infinity()};
+    long long children = 0;                    // dzieci utworzone w bieżącym pokoleniu
+    long long cacheHits = 0;                   // w tym koszt wzięty z pamięci lub od rodzica
+    long long duplicates = 0;                  // odrzucone duplikaty osobników populacji
+    // Ocena wsadowa (batch_evaluation): wiersze następnego pokolenia czekające na koszt, ich skróty,
+    // pary (wiersz, wiersz czekający z tym samym skrótem) oraz bufory evaluateBatch.
+    std::vector<int> pending;
+    std::vector<std::uint64_t> pendingHashes;
+    std::vector<std::pair<int, int>> aliases;
+    std::vector<int> offsets;
+    std::vector<double> costs;
+};
+
+// Liczba prób wygenerowania dziecka spoza populacji przy ea_reject_duplicates; ostatnia próba jest przyjmowana.
+static const int kDuplicateAttempts = 4;
+
+// Liczba dzieci w jednym zadaniu trybu równoległego; stała, aby wynik nie zależał od liczby wątków.
+static const int kEaChunk = 32;
+
+// Liczba próbek przeszukiwania losowego i dzieci EA ocenianych razem przy batch_evaluation.
+static const int kRandomBatch = 64;
+static const int kEaBatch = 64;
+
+// Buduje permutację metodą najbliższego sąsiada startując z podanego węzła. Najbliższy
+// nieodwiedzony to pierwszy nieodwiedzony na liście kandydatów; dopiero gdy cała lista jest
+// odwiedzona, przeglądamy pozostałych klientów.
+// Szybka ścieżka małych instancji (id < 64 * Words): nieodwiedzeni w NodeBitset na stosie zamiast
+// tablic na stercie, a przegląd pozostałych klientów idzie po bitach rosnąco (remis - mniejsze id).
+template <int Words>
+static void buildGreedySmall(const Problem& problem, int startId, std::vector<int>& order) {
+    NodeBitset<Words> unvisited;
+    int firstId = -1;
     for (const auto& node : problem.nodes) {
-        if (node.id != problem.depotId) unvisited.insert(node.id);
+        if (node.id == problem.depotId) continue;
+        if (firstId < 0) firstId = node.id;
+        unvisited.set(node.id);
     }
-    std::vector<int> order;
-    order.reserve(problem.dimension - 1);
-    int current = unvisited.count(startId) ? startId : *unvisited.begin();
-    while (!unvisited.empty()) {
+    if (firstId < 0) return;
+    order.reserve(unvisited.count());
+    int current = startId >= 1 && startId <= problem.dimension && unvisited.test(startId) ? startId : firstId;
+    const int k = problem.candidates.k();
+    while (true) {
         order.push_back(current);
-        unvisited.erase(current);
+        unvisited.reset(current);
         if (unvisited.empty()) break;
-        double bestDist = std::numeric_limits<double>::infinity();
-        int bestNext = *unvisited.begin();
-        for (int candidate : unvisited) {
-            double dist = problem.distances[current][candidate];
-            if (dist < bestDist) {
-                bestDist = dist;
-                bestNext = candidate;
+        int bestNext = -1;
+        const int* candidates = problem.candidates.of(current);
+        for (int c = 0; c < k; ++c) {
+            if (unvisited.test(candidates[c])) {
+                bestNext = candidates[c];
+                break;
             }
         }
+        if (bestNext < 0) {
+            DistanceValue bestDist = std::numeric_limits<DistanceValue>::max();
+            const DistanceValue* row = problem.distances.row(current);
+            unvisited.forEach([&](int candidate) {
+                if (row[candidate] < bestDist) {
+                    bestDist = row[candidate];
+                    bestNext = candidate;
+                }
+            });
+        }
         current = bestNext;
     }
-    return order;
 }
 
-// Tworzy sąsiada przez zamianę dwóch losowych pozycji w permutacji.
-static std::vector<int> swapNeighbor(const std::vector<int>& perm) {
-    std::vector<int> result = perm;
-    if (result.size() < 2) return result;
-    int i = randInt(0, static_cast<int>(result.size()) - 1);
-    int j = randInt(0, static_cast<int>(result.size()) - 1);
-    while (j == i) j = randInt(0, static_cast<int>(result.size()) - 1);
-    std::swap(result[i], result[j]);
-    return result;
+static std::vector<int> buildGreedyPermutation(const Problem& problem, int startId) {
+    std::vector<int> order;
+    auto small = [&](auto words) { buildGreedySmall<decltype(words)::value>(problem, startId, order); };
+    if (dispatchSmallPath(problem.dimension, small)) return order;
+    // Nieodwiedzeni w zwartej tablicy (usuwanie przez zamianę z ostatnim) i bitset odwiedzin.
+    std::vector<int> unvisited;
+    std::vector<int> slotOf(problem.dimension + 1, -1);
+    std::vector<std::uint64_t> visited((problem.dimension + 64) / 64, 0);
+    for (const auto& node : problem.nodes) {
+        if (node.id == problem.depotId) continue;
+        slotOf[node.id] = static_cast<int>(unvisited.size());
+        unvisited.push_back(node.id);
+    }
+    order.reserve(unvisited.size());
+    if (unvisited.empty()) return order;
+    auto isVisited = [&](int id) { return (visited[id >> 6] >> (id & 63)) & 1u; };
+    int current = startId >= 1 && startId <= problem.dimension && slotOf[startId] >= 0 ? startId : unvisited[0];
+    const int k = problem.candidates.k();
+    while (true) {
+        order.push_back(current);
+        visited[current >> 6] |= std::uint64_t{1} << (current & 63);
+        int slot = slotOf[current];
+        slotOf[unvisited.back()] = slot;
+        unvisited[slot] = unvisited.back();
+        unvisited.pop_back();
+        if (unvisited.empty()) break;
+        int bestNext = -1;
+        const int* candidates = problem.candidates.of(current);
+        for (int c = 0; c < k; ++c) {
+            if (!isVisited(candidates[c])) {
+                bestNext = candidates[c];
+                break;
+            }
+        }
+        if (bestNext < 0) {
+            DistanceValue bestDist = std::numeric_limits<DistanceValue>::max();
+            const DistanceValue* row = problem.distances.row(current);
+            for (int candidate : unvisited) {
+                if (row[candidate] < bestDist || (row[candidate] == bestDist && candidate < bestNext)) {
+                    bestDist = row[candidate];
+                    bestNext = candidate;
+                }
+            }
+        }
+        current = bestNext;
+    }
+    return order;
 }
 
-// Wielokrotne losowe próbkowanie permutacji; zwraca najlepszą znalezioną.
-Solution runRandomSearch(const Problem& problem, int iterations, CSVLogger& logger) {
-    Solution bestSolution;
-    bestSolution.cost = std::numeric_limits<double>::infinity();
+// Wielokrotne losowe próbkowanie permutacji; zwraca najlepszą znalezioną. Przy batch_evaluation
+// (dekoder greedy) permutacje są losowane blokami po kRandomBatch i oceniane razem evaluateBatch,
+// a potem przetwarzane po kolei jak pojedyncze próbki (ten sam log i budżet; po stopie w środku bloku
+// reszta bloku jest pomijana).
+Solution runRandomSearch(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget) {
+    const int iterations = cfg.randomIterations;
+    const DecoderType decoder = parseDecoderType(cfg.decoder, cfg.splitFleetLimit);
+    const bool batched = cfg.batchEvaluation && decoder == DecoderType::Greedy;
+    const int genes = problem.dimension - 1;
+    const int block = batched ? kRandomBatch : 1;
+    std::vector<int> perm;
+    std::vector<int> samples(static_cast<std::size_t>(block) * genes);
+    std::vector<int> offsets(block);
+    std::vector<double> costs(block);
+    for (int s = 0; s < block; ++s) offsets[s] = s * genes;
+    std::vector<int> bestPerm;
+    double bestCost = std::numeric_limits<double>::infinity();
     double sumCost = 0.0;
     double worstCost = -std::numeric_limits<double>::infinity();
-    for (int iter = 0; iter < iterations; ++iter) {
-        std::vector<int> perm = randomPermutation(problem);
-        Solution sol = decodePermutation(problem, perm);
-        sumCost += sol.cost;
-        if (sol.cost < bestSolution.cost) bestSolution = sol;
-        if (sol.cost > worstCost) worstCost = sol.cost;
-        double avgCost = sumCost / static_cast<double>(iter + 1);
-        logger.logRow(std::to_string(iter) + "," + std::to_string(bestSolution.cost) + "," +
-                      std::to_string(sol.cost) + "," + std::to_string(avgCost) + "," +
-                      std::to_string(worstCost));
-    }
-    return bestSolution;
-}
-
-// Pojedynczy bieg greedy od wybranego startu.
-static Solution greedyOnce(const Problem& problem, int startId) {
-    std::vector<int> perm = buildGreedyPermutation(problem, startId);
-    return decodePermutation(problem, perm);
+    bool stop = false;
+    for (int iter = 0; iter < iterations && !stop;) {
+        const int count = std::min(block, iterations - iter);
+        for (int s = 0; s < count; ++s) {
+            fillRandomPermutation(problem, perm);
+            std::copy(perm.begin(), perm.end(), samples.begin() + offsets[s]);
+            if (!batched) costs[s] = decodeCost(problem, perm, decoder);
+        }
+        if (batched) evaluateBatch(problem, samples.data(), offsets.data(), count, genes, costs.data());
+        for (int s = 0; s < count && !stop; ++s, ++iter) {
+            double cost = costs[s];
+            budget.spend();
+            sumCost += cost;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestPerm.assign(samples.begin() + offsets[s], samples.begin() + offsets[s] + genes);
+                budget.markBest(cost);
+            }
+            if (cost > worstCost) worstCost = cost;
+            double avgCost = sumCost / static_cast<double>(iter + 1);
+            logger.log(iter, bestCost, cost, avgCost, worstCost);
+            stop = budget.step();
+        }
+    }
+    if (bestPerm.empty()) return Solution{{}, {}, bestCost};
+    return decodePermutation(problem, bestPerm, decoder);
 }
 
 // Wiele restartów greedy; loguje postęp i zwraca najlepszy wynik.
-Solution runGreedy(const Problem& problem, int restarts, CSVLogger& logger) {
-    Solution bestSolution;
-    bestSolution.cost = std::numeric_limits<double>::infinity();
+Solution runGreedy(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget) {
+    const int restarts = cfg.greedyRestarts;
+    const DecoderType decoder = parseDecoderType(cfg.decoder, cfg.splitFleetLimit);
+    std::vector<int> bestPerm;
+    double bestCost = std::numeric_limits<double>::infinity();
     double worstCost = -std::numeric_limits<double>::infinity();
     double sumCost = 0.0;
     for (int r = 0; r < restarts; ++r) {
         int startId = 2 + (r % (problem.dimension - 1));
-        Solution sol = greedyOnce(problem, startId);
-        sumCost += sol.cost;
-        if (sol.cost < bestSolution.cost) bestSolution = sol;
-        if (sol.cost > worstCost) worstCost = sol.cost;
+        std::vector<int> perm = buildGreedyPermutation(problem, startId);
+        double cost = decodeCost(problem, perm, decoder);
+        budget.spend();
+        sumCost += cost;
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestPerm = std::move(perm);
+            budget.markBest(cost);
+        }
+        if (cost > worstCost) worstCost = cost;
         double avgCost = sumCost / static_cast<double>(r + 1);
-        logger.logRow(std::to_string(r) + "," + std::to_string(bestSolution.cost) + "," +
-                      std::to_string(sol.cost) + "," + std::to_string(avgCost) + "," +
-                      std::to_string(worstCost));
+        logger.log(r, bestCost, cost, avgCost, worstCost);
+        if (budget.step()) break;
+    }
+    if (bestPerm.empty()) return Solution{{}, {}, bestCost};
+    return decodePermutation(problem, bestPerm, decoder);
+}
+
+// Ścieżka logu pomocniczego runu: ("ea_run_3.csv", "_island_1") -> "ea_run_3_island_1.csv" (tak samo dla .vlog).
+static std::string sideLogPath(const std::string& runPath, const std::string& suffix) {
+    size_t dot = runPath.rfind('.');
+    if (dot == std::string::npos) return runPath + suffix;
+    return runPath.substr(0, dot) + suffix + runPath.substr(dot);
+}
+
+// Log pomocniczy runu (wyspa, replika) obok logu runu, w jego formacie i z jego polityką zapisu. Gdy
+// run nie ma pliku logu (np. log_mode=aggregate), zwraca logger bez pliku.
+static std::unique_ptr<CSVLogger> openSideLog(const CSVLogger& runLog, const std::string& suffix,
+                                              const std::string& header) {
+    if (!runLog.ok()) return std::make_unique<CSVLogger>();
+    auto side = std::make_unique<CSVLogger>(sideLogPath(runLog.path(), suffix), header, runLog.format());
+    side->setPolicy(runLog.rowPolicy(), runLog.rowEvery());
+    return side;
+}
+
+// Krok Metropolisa z sąsiedztwem swap w temperaturze temp: losowa zamiana oceniona przyrostowo,
+// potem zatwierdzenie albo cofnięcie. Dolicza ocenę do budżetu; zwraca, czy ruch przyjęto.
+static bool metropolisSwap(SwapDeltaEvaluator& state, int n, double& currentCost, double temp, Budget& budget) {
+    double neighborCost = currentCost;
+    if (n >= 2) {
+        int i = randInt(0, n - 1);
+        int j = randInt(0, n - 1);
+        while (j == i) j = randInt(0, n - 1);
+        neighborCost = state.applySwap(i, j);
+    }
+    budget.spend();
+    double delta = neighborCost - currentCost;
+    bool accept = delta < 0 || randUnit() < std::exp(-delta / temp);
+    if (n >= 2) {
+        if (accept) state.commit();
+        else state.undo();
+    }
+    if (accept) currentCost = neighborCost;
+    return accept;
+}
+
+// Najlepsza permutacja SA jako rozwiązanie, opcjonalnie doszlifowane przeszukiwaniem lokalnym na trasach.
+static Solution finishAnnealing(const Problem& problem, const Config& cfg, const std::vector<int>& bestPerm,
+                                DecoderType decoder) {
+    Solution best = decodePermutation(problem, bestPerm, decoder);
+    if (cfg.saLocalSearch) LocalSearch(problem).improve(best, parseLsStrategy(cfg.lsStrategy));
+    return best;
+}
+
+// Replika równoległego odpuszczania: łańcuch Metropolisa na jednym wątku.
+struct TemperingReplica {
+    std::unique_ptr<SwapDeltaEvaluator> state;
+    double cost = 0.0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    std::vector<int> bestPerm;
+    long long steps = 0;
+};
+
+// Wymiany między szczeblami k i k + 1 drabiny temperatur.
+struct LadderPair {
+    long long attempts = 0;
+    long long accepted = 0;
+    double recentRate = 0.0;  // średnia krocząca przyjęć (strojenie drabiny adaptive)
+};
+
+// Równoległe odpuszczanie (parallel tempering, sa_replicas > 1): każda replika na własnym wątku
+// wykonuje kroki Metropolisa w temperaturze swojego szczebla drabiny (od sa_min_temp do
+// sa_initial_temp, geometrycznie). Co sa_exchange_interval kroków repliki spotykają się na barierze,
+// a ostatnia przybyła proponuje wymiany sąsiednich szczebli (na przemian pary parzyste i nieparzyste)
+// z prawdopodobieństwem min(1, exp((1/T_k - 1/T_k+1)(E_k - E_k+1))). Wymiana zamienia temperatury,
+// a nie permutacje, więc synchronizacja to jedna bariera na rundę. Decyzje losuje własny strumień
+// rundy, więc wynik jest powtarzalny. Bez budżetu (lub bez sa_auto_cooling) każda replika wykonuje
+// tyle kroków, ile zwykłe chłodzenie; z budżetem i sa_auto_cooling - do jego wyczerpania. Repliki
+// dzielą budżet ocen jak wyspy EA. Log runu ma wiersz na rundę (best ze wszystkich replik, current
+// najzimniejszej, średni i najgorszy current), log repliki - jej trajektorię z temperaturą, a plik
+// _exchanges - statystyki wymian par szczebli.
+static Solution runParallelTempering(const Problem& problem, const Config& cfg, DecoderType decoder,
+                                     CSVLogger& logger, Budget& budget) {
+    const int replicaCount = cfg.saReplicas;
+    const int interval = std::max(1, cfg.saExchangeInterval);
+    const bool adaptive = toLowerCopy(cfg.saLadder) == "adaptive";
+    const bool untilBudget = cfg.saAutoCooling && budget.limited();
+    double levels = 0.0;
+    for (double t = cfg.saInitialTemp; t > cfg.saMinTemp && levels < 1e7; t *= cfg.saCoolingRate) levels += 1.0;
+    const long long stepLimit = std::max(1LL, static_cast<long long>(levels) * cfg.saIterations);
+
+    // Szczebel 0 jest najzimniejszy; gaps to odstępy log T między kolejnymi szczeblami.
+    const double hot = std::max(cfg.saInitialTemp, cfg.saMinTemp);
+    const double cold = std::max(std::min(cfg.saInitialTemp, cfg.saMinTemp), hot * 1e-9);
+    const double span = std::log(hot / cold);
+    std::vector<double> gaps(replicaCount - 1, span / (replicaCount - 1));
+    std::vector<double> temps(replicaCount);
+    auto rebuildLadder = [&] {
+        temps[0] = cold;
+        for (int k = 1; k < replicaCount; ++k) temps[k] = temps[k - 1] * std::exp(gaps[k - 1]);
+    };
+    rebuildLadder();
+    std::vector<int> replicaAt(replicaCount), slotOf(replicaCount);
+    for (int r = 0; r < replicaCount; ++r) replicaAt[r] = slotOf[r] = r;
+    std::vector<LadderPair> pairs(replicaCount - 1);
+
+    std::vector<TemperingReplica> replicas(replicaCount);
+    std::vector<Budget> budgets(replicaCount, budget.share(replicaCount));
+    const std::uint64_t streamBase = threadRng()();
+    long long round = 0;
+    std::atomic<bool> finished{false};
+    // Błąd w replice: pozostałe czekają na barierze, więc replika z błędem dalej do niej przychodzi,
+    // a koniec najbliższej rundy kończy run; błąd jest potem przekazywany dalej.
+    std::atomic<bool> failed{false};
+    std::exception_ptr replicaError;
+    std::mutex errorMutex;
+
+    // Koniec rundy (pod blokadą bariery): warunki stopu, wymiany, strojenie drabiny i wiersz logu runu.
+    auto exchange = [&] {
+        if (failed.load()) {
+            finished = true;
+            return;
+        }
+        ++round;
+        bool allExhausted = true;
+        bool targetReached = false;
+        for (const Budget& own : budgets) {
+            allExhausted = allExhausted && own.exhausted();
+            targetReached = targetReached || own.stopReason() == StopReason::Target;
+        }
+        if (targetReached) {
+            for (Budget& own : budgets) own.stop(StopReason::Target);
+        }
+        finished = allExhausted || targetReached || (!untilBudget && round * interval >= stepLimit);
+
+        ScopedRngStream stream(deriveSubstreamSeed(streamBase, static_cast<std::uint64_t>(replicaCount),
+                                                   static_cast<std::uint64_t>(round)));
+        for (int k = static_cast<int>(round % 2); k + 1 < replicaCount; k += 2) {
+            const int colder = replicaAt[k], hotter = replicaAt[k + 1];
+            double exponent = (1.0 / temps[k] - 1.0 / temps[k + 1]) * (replicas[colder].cost - replicas[hotter].cost);
+            bool swapped = exponent >= 0.0 || randUnit() < std::exp(exponent);
+            LadderPair& pair = pairs[k];
+            ++pair.attempts;
+            pair.accepted += swapped;
+            pair.recentRate += 0.1 * ((swapped ? 1.0 : 0.0) - pair.recentRate);
+            if (swapped) {
+                std::swap(replicaAt[k], replicaAt[k + 1]);
+                slotOf[colder] = k + 1;
+                slotOf[hotter] = k;
+            }
+        }
+        if (adaptive && replicaCount > 2) {
+            // Para z przyjęciami powyżej celu dostaje szerszy odstęp, poniżej - węższy; suma odstępów
+            // (końce drabiny) się nie zmienia, a krok maleje z rundami.
+            const double rate = 0.5 / std::sqrt(static_cast<double>(round));
+            double total = 0.0;
+            for (int k = 0; k + 1 < replicaCount; ++k) {
+                gaps[k] *= std::exp(rate * (pairs[k].recentRate - cfg.saTargetSwapRate));
+                total += gaps[k];
+            }
+            for (double& gap : gaps) gap *= span / total;
+            rebuildLadder();
+        }
+
+        double best = std::numeric_limits<double>::infinity();
+        double sum = 0.0, worst = -std::numeric_limits<double>::infinity();
+        long long steps = 0;
+        for (const TemperingReplica& replica : replicas) {
+            best = std::min(best, replica.bestCost);
+            sum += replica.cost;
+            worst = std::max(worst, replica.cost);
+            steps = std::max(steps, replica.steps);
+        }
+        logger.log(steps, best, replicas[replicaAt[0]].cost, sum / replicaCount, worst);
+    };
+
+    // Logi replik są otwierane przed startem wątków (błąd nie zostawia innych replik na barierze).
+    std::vector<std::unique_ptr<CSVLogger>> replicaLogs;
+    for (int r = 0; r < replicaCount; ++r) {
+        replicaLogs.push_back(
+            openSideLog(logger, "_replica_" + std::to_string(r), "step,best,current,avg,worst,temperature"));
     }
-    return bestSolution;
+
+    RunMetrics* metrics = currentMetrics();
+    std::mutex metricsMutex;
+    Barrier barrier(replicaCount);
+    ThreadPool pool(replicaCount);
+    auto runReplica = [&](int r) {
+        CSVLogger* replicaLog = replicaLogs[r].get();
+        TemperingReplica& replica = replicas[r];
+        Budget& own = budgets[r];
+        replica.state = std::make_unique<SwapDeltaEvaluator>(problem, randomPermutation(problem), decoder);
+        own.spend();
+        const int n = static_cast<int>(replica.state->permutation().size());
+        replica.cost = replica.bestCost = replica.state->cost();
+        replica.bestPerm = replica.state->permutation();
+        own.markBest(replica.cost);
+        double sumCost = replica.cost;
+        double worstCost = replica.cost;
+        replicaLog->log(0, replica.bestCost, replica.cost, replica.cost, worstCost, temps[slotOf[r]]);
+        while (true) {
+            // Temperatury i szczeble zmienia tylko koniec rundy, gdy wszystkie repliki czekają.
+            const double temp = temps[slotOf[r]];
+            long long roundEnd = replica.steps + interval;
+            if (!untilBudget) roundEnd = std::min(roundEnd, stepLimit);
+            while (replica.steps < roundEnd && !own.exhausted()) {
+                metropolisSwap(*replica.state, n, replica.cost, temp, own);
+                ++replica.steps;
+                if (replica.cost < replica.bestCost) {
+                    replica.bestCost = replica.cost;
+                    replica.bestPerm = replica.state->permutation();
+                    own.markBest(replica.cost);
+                }
+                worstCost = std::max(worstCost, replica.cost);
+                sumCost += replica.cost;
+                replicaLog->log(replica.steps, replica.bestCost, replica.cost,
+                                sumCost / static_cast<double>(replica.steps + 1), worstCost, temp);
+                own.step();
+            }
+            barrier.arriveAndWait(exchange);
+            if (finished) break;
+        }
+    };
+    pool.parallelFor(replicaCount, [&](int r) {
+        ScopedRngStream stream(deriveSubstreamSeed(streamBase, static_cast<std::uint64_t>(r), 0));
+        WorkerMetrics metricsScope(metrics, metricsMutex);
+        try {
+            runReplica(r);
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!replicaError) replicaError = std::current_exception();
+            }
+            failed = true;
+            while (!finished) {
+                try {
+                    barrier.arriveAndWait(exchange);
+                } catch (...) {
+                }
+            }
+        }
+    });
+    if (replicaError) std::rethrow_exception(replicaError);
+
+    if (logger.ok()) {
+        CSVLogger exchangeLog(sideLogPath(logger.path(), "_exchanges"),
+                              "pair,temperature_low,temperature_high,attempts,accepted,rate", logger.format());
+        for (int k = 0; k + 1 < replicaCount; ++k) {
+            const LadderPair& pair = pairs[k];
+            double rate = pair.attempts > 0 ? static_cast<double>(pair.accepted) / pair.attempts : 0.0;
+            exchangeLog.log(k, temps[k], temps[k + 1], pair.attempts, pair.accepted, rate);
+        }
+    }
+    int bestReplica = 0;
+    for (int r = 1; r < replicaCount; ++r) {
+        if (replicas[r].bestCost < replicas[bestReplica].bestCost) bestReplica = r;
+    }
+    for (int r = 0; r < replicaCount; ++r) budget.absorb(budgets[r], replicaCount, r == bestReplica);
+    return finishAnnealing(problem, cfg, replicas[bestReplica].bestPerm, decoder);
 }
 
-// Symulowane wyżarzanie z sąsiedztwem swap i stałym chłodzeniem.
-Solution runSimulatedAnnealing(const Problem& problem, const Config& cfg, CSVLogger& logger) {
-    std::vector<int> currentPerm = randomPermutation(problem);
-    Solution currentSol = decodePermutation(problem, currentPerm);
-    Solution bestSol = currentSol;
+// Symulowane wyżarzanie z sąsiedztwem swap i stałym chłodzeniem; przy ustawionym budżecie
+// i sa_auto_cooling temperatura spada geometrycznie od sa_initial_temp do sa_min_temp wraz ze
+// zużytą częścią budżetu, a run trwa do jego wyczerpania.
+// Ruch swap jest stosowany w miejscu i oceniany przyrostowo (SwapDeltaEvaluator), a odrzucony cofany.
+// Dla sa_replicas > 1 zamiast chłodzenia działa równoległe odpuszczanie (runParallelTempering).
+Solution runSimulatedAnnealing(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget) {
+    const DecoderType decoder = parseDecoderType(cfg.decoder, cfg.splitFleetLimit);
+    if (cfg.saReplicas > 1) return runParallelTempering(problem, cfg, decoder, logger, budget);
+    const bool autoCooling = cfg.saAutoCooling && budget.limited();
+    SwapDeltaEvaluator state(problem, randomPermutation(problem), decoder);
+    budget.spend();
+    const int n = static_cast<int>(state.permutation().size());
+    double currentCost = state.cost();
+    budget.markBest(currentCost);
+    double bestCost = currentCost;
+    std::vector<int> bestPerm = state.permutation();
     double temp = cfg.saInitialTemp;
-    double worstCost = currentSol.cost;
-    double sumCost = currentSol.cost;
+    double worstCost = currentCost;
+    double sumCost = currentCost;
     int steps = 1;
     int iterationCounter = 0;
     // Zaloguj stan początkowy z best=current=avg=worst.
-    logger.logRow("0," + std::to_string(bestSol.cost) + "," + std::to_string(currentSol.cost) + "," +
-                  std::to_string(currentSol.cost) + "," + std::to_string(worstCost));
+    logger.log(0, bestCost, currentCost, currentCost, worstCost);
     iterationCounter = 1;
-    while (temp > cfg.saMinTemp) {
-        for (int k = 0; k < cfg.saIterations; ++k) {
-            std::vector<int> neighborPerm = swapNeighbor(currentPerm);
-            Solution neighborSol = decodePermutation(problem, neighborPerm);
-            double delta = neighborSol.cost - currentSol.cost;
-            bool accept = delta < 0 || randUnit() < std::exp(-delta / temp);
-            if (accept) {
-                currentPerm = neighborPerm;
-                currentSol = neighborSol;
+    while (!budget.exhausted() && (autoCooling || temp > cfg.saMinTemp)) {
+        int accepted = 0;
+        int k = 0;
+        for (; k < cfg.saIterations; ++k) {
+            if (metropolisSwap(state, n, currentCost, temp, budget)) ++accepted;
+            if (currentCost < bestCost) {
+                bestCost = currentCost;
+                bestPerm = state.permutation();
+                budget.markBest(bestCost);
             }
-            if (currentSol.cost < bestSol.cost) bestSol = currentSol;
-            if (currentSol.cost > worstCost) worstCost = currentSol.cost;
-            sumCost += currentSol.cost;
+            if (currentCost > worstCost) worstCost = currentCost;
+            sumCost += currentCost;
             steps += 1;
             double avgCost = sumCost / static_cast<double>(steps);
-            logger.logRow(std::to_string(iterationCounter) + "," + std::to_string(bestSol.cost) + "," +
-                          std::to_string(currentSol.cost) + "," + std::to_string(avgCost) + "," +
-                          std::to_string(worstCost));
+            logger.log(iterationCounter, bestCost, currentCost, avgCost, worstCost);
             iterationCounter += 1;
+            if (budget.step()) {
+                ++k;
+                break;
+            }
         }
-        temp *= cfg.saCoolingRate;
+        VRP_SA_ACCEPTANCE(k > 0 ? static_cast<double>(accepted) / k : 0.0);
+        if (autoCooling) temp = cfg.saInitialTemp * std::pow(cfg.saMinTemp / cfg.saInitialTemp, budget.fraction());
+        else temp *= cfg.saCoolingRate;
     }
-    return bestSol;
+    return finishAnnealing(problem, cfg, bestPerm, decoder);
 }
 
-// Krzyżowanie OX: segment z p1, reszta w kolejności p2, bez duplikatów.
-static std::vector<int> orderedCrossover(const std::vector<int>& p1, const std::vector<int>& p2) {
-    int n = static_cast<int>(p1.size());
-    std::vector<int> child(n, -1);
-    int a = randInt(0, n - 1);
-    int b = randInt(0, n - 1);
-    if (a > b) std::swap(a, b);
-    for (int i = a; i <= b; ++i) child[i] = p1[i];
-    int idx = (b + 1) % n;
-    for (int i = 0; i < n; ++i) {
-        int candidate = p2[(b + 1 + i) % n];
-        bool used = false;
-        for (int val : child) if (val == candidate) { used = true; break; }
-        if (used) continue;
-        while (child[idx] != -1) idx = (idx + 1) % n;
-        child[idx] = candidate;
-    }
-    return child;
+// Statystyki jednego pokolenia populacji.
+struct GenerationStats {
+    double best;
+    double avg;
+    double worst;
+    double cacheHitRate;  // ułamek dzieci tego pokolenia, których nie trzeba było dekodować
+    long long duplicates; // dzieci odrzucone jako duplikaty przy tworzeniu tego pokolenia
+};
+
+// Populacja EA rozwijana pokolenie po pokoleniu (cały run albo jedna wyspa modelu wyspowego).
+class EvolutionRun {
+  public:
+    // Inicjalizuje populację (część zachłannie, reszta losowo) bieżącym generatorem wątku.
+    // Dla eaThreads != 1 tworzy własną pulę wątków do generowania potomstwa. Oceny (także
+    // inicjalizacji) i nowe najlepsze wyniki trafiają do `budget`, sprawdzanego co pokolenie.
+    EvolutionRun(const Problem& problem, const Config& cfg, DecoderType decoder, int eaThreads, Budget& budget);
+
+    // Liczy statystyki bieżącej populacji i aktualizuje najlepszego osobnika.
+    GenerationStats evaluateGeneration();
+    // Tworzy następne pokolenie (elity + potomstwo).
+    void advance(int gen);
+    // Kopiuje `count` najlepszych osobników do out.
+    void emigrants(int count, std::vector<Individual>& out);
+    // Zastępuje najgorszych osobników imigrantami.
+    void immigrate(const std::vector<Individual>& migrants);
+    // Różnorodność populacji: średni ułamek krawędzi (par sąsiednich genów, bez kierunku) nieobecnych
+    // u najlepszego osobnika ostatnio ocenionego pokolenia; 0 - wszyscy mają te same krawędzie. O(P n).
+    double diversity();
+    // Najlepszy osobnik znaleziony dotąd.
+    const Individual& best() const { return bestOverall; }
+    // Rozwiązanie najlepszego osobnika: trasy LS, gdy jego koszt pochodzi z tras (RouteEducation przy
+    // dekoderze greedy), inaczej zdekodowana permutacja.
+    Solution bestSolution() const;
+
+  private:
+    // Tworzy dziecko w wierszu `slot` następnego pokolenia operatorami z polityk (EaPolicies.h).
+    template <typename Crossover, typename Mutation, typename Education, typename Decoding>
+    void makeChild(int slot, EaScratch& work);
+    // Dzieci w wierszach [begin, end); konkretyzacja wybierana raz w konstruktorze (breed).
+    template <typename Crossover, typename Mutation, typename Education, typename Decoding>
+    void breedRange(int begin, int end, EaScratch& work) {
+        for (int i = begin; i < end; ++i) makeChild<Crossover, Mutation, Education, Decoding>(i, work);
+    }
+    // Ocenia razem dzieci odłożone przez makeChild (batch_evaluation) i zapisuje ich koszty.
+    void flushBatch(EaScratch& work);
+    // Czy skrót należy do osobnika bieżącej populacji (sortedHashes).
+    bool inPopulation(std::uint64_t hash) const {
+        return std::binary_search(sortedHashes.begin(), sortedHashes.end(), hash);
+    }
+    // Indeksy osobników posortowane tak, że pierwsze `count` to najlepsi (rosnąco; remis - niższy indeks).
+    const std::vector<int>& rankBest(int count);
+
+    const Problem& problem;
+    const Config& cfg;
+    Budget& budget;
+    DecoderType decoder;
+    bool batched;                          // batch_evaluation z dekoderem greedy
+    LsStrategy lsStrategy;
+    void (EvolutionRun::*breed)(int, int, EaScratch&);  // breedRange dla operatorów z konfiguracji
+    Population population;
+    Population nextPop;                    // drugi bufor: następne pokolenie
+    std::vector<int> order;                // indeksy osobników do wyboru elit
+    std::vector<std::uint64_t> sortedHashes;  // skróty bieżącej populacji (ea_reject_duplicates)
+    FitnessCache cache;                    // koszty według skrótu permutacji (ea_cache_size)
+    double lastHitRate = 0.0;              // statystyki tworzenia bieżącego pokolenia
+    long long lastDuplicates = 0;
+    int generationBest = 0;                // najlepszy osobnik ostatnio ocenionego pokolenia
+    std::vector<int> bestNext, bestPrev;   // sąsiedzi genów w nim (diversity)
+    Individual bestOverall;
+    std::unique_ptr<ThreadPool> pool;      // pula dla ea_threads != 1
+    std::vector<EaScratch> scratch;        // bufory robocze per wątek
+    std::uint64_t streamBase = 0;          // baza strumieni losowych fragmentów
+    RunMetrics* metrics = currentMetrics(); // pomiary runu (wątki robocze dołączają swoje)
+    std::mutex metricsMutex;
+};
+
+EvolutionRun::EvolutionRun(const Problem& problem, const Config& cfg, DecoderType decoder, int eaThreads,
+                           Budget& budget)
+    : problem(problem), cfg(cfg), budget(budget), decoder(decoder),
+      batched(cfg.batchEvaluation && decoder == DecoderType::Greedy), lsStrategy(parseLsStrategy(cfg.lsStrategy)),
+      cache(static_cast<std::size_t>(std::max(0, cfg.eaCacheSize))) {
+    const int genes = problem.dimension - 1;
+    population = Population(cfg.eaPopulation, genes);
+    int greedyCount = static_cast<int>(std::round(cfg.eaGreedyInitFraction * cfg.eaPopulation));
+    int startId = 2;
+    for (int i = 0; i < cfg.eaPopulation; ++i) {
+        std::vector<int> perm;
+        if (i < greedyCount) {
+            perm = buildGreedyPermutation(problem, startId);
+            startId = 2 + ((startId - 1) % (problem.dimension - 1));
+        } else {
+            perm = randomPermutation(problem);
+        }
+        double cost = decodeCost(problem, perm, decoder);
+        budget.spend();
+        std::uint64_t hash = permutationHash(perm.data(), genes);
+        if (cache.enabled()) cache.store(hash, cost);
+        population.assign(i, perm.data(), cost, hash);
+    }
+    int best = 0;
+    for (int i = 1; i < population.size(); ++i) if (population.cost(i) < population.cost(best)) best = i;
+    bestOverall.perm.assign(population.row(best), population.row(best) + genes);
+    bestOverall.cost = population.cost(best);
+    budget.markBest(bestOverall.cost);
+
+    // Następne pokolenie ma własny blok tych samych wymiarów; bufory są wymieniane co pokolenie.
+    nextPop = Population(population.size(), genes);
+    order.resize(population.size());
+    if (eaThreads != 1) pool = std::make_unique<ThreadPool>(eaThreads);
+    scratch.resize(pool ? pool->size() : 1);
+    for (auto& work : scratch) {
+        work.crossoverWork = CrossoverWorkspace(problem.dimension + 1);
+        if (!batched) continue;
+        work.pending.reserve(kEaBatch);
+        work.pendingHashes.reserve(kEaBatch);
+        work.aliases.reserve(kEaBatch);
+        work.offsets.reserve(kEaBatch);
+        work.costs.reserve(kEaBatch);
+    }
+    const bool routeEducation = toLowerCopy(cfg.eaLocalSearch) == "routes";
+    if (routeEducation) {
+        for (auto& work : scratch) work.localSearch = std::make_unique<LocalSearch>(problem);
+    }
+    breed = dispatchEaPolicies(parseCrossoverType(toLowerCopy(cfg.eaCrossoverType)),
+                               parseMutationType(toLowerCopy(cfg.eaMutationType)), routeEducation, decoder,
+                               [](auto crossover, auto mutation, auto education, auto decoding) {
+                                   return &EvolutionRun::breedRange<decltype(crossover), decltype(mutation),
+                                                                    decltype(education), decltype(decoding)>;
+                               });
+    streamBase = pool ? threadRng()() : 0;
 }
 
-// Krzyżowanie PMX: mapuje segment z p1 na p2 i wypełnia zgodnie z odwzorowaniem.
-static std::vector<int> pmxCrossover(const std::vector<int>& p1, const std::vector<int>& p2) {
-    int n = static_cast<int>(p1.size());
-    std::vector<int> child(n, -1);
-    int a = randInt(0, n - 1);
-    int b = randInt(0, n - 1);
-    if (a > b) std::swap(a, b);
-    // Skopiuj segment z p1.
-    for (int i = a; i <= b; ++i) {
-        child[i] = p1[i];
-    }
-    auto contains = [&](int val) {
-        return std::find(child.begin(), child.end(), val) != child.end();
-    };
-    // Mapowanie elementów z p2 do dziecka.
-    for (int i = a; i <= b; ++i) {
-        int val = p2[i];
-        if (contains(val)) continue;
-        int pos = i;
-        int mapped = val;
-        // Znajdź pozycję, która nie jest jeszcze zajęta zgodnie z mapowaniem.
-        while (child[pos] != -1) {
-            mapped = p1[pos];
-            pos = static_cast<int>(std::find(p2.begin(), p2.end(), mapped) - p2.begin());
+template <typename Crossover, typename Mutation, typename Education, typename Decoding>
+void EvolutionRun::makeChild(int slot, EaScratch& work) {
+    VRP_SAMPLE_PHASES();
+    const int genes = population.genes();
+    int p1Idx = 0;
+    std::uint64_t hash = 0;
+    bool copied = false;  // dziecko jest niezmienioną kopią rodzica p1Idx
+    bool routed = false;  // kosztem dziecka jest koszt tras LS w work.routes
+    for (int attempt = 1;; ++attempt) {
+        routed = false;
+        int p2Idx = 0;
+        {
+            VRP_PHASE(Selection);
+            p1Idx = tournamentSelect(population, cfg.eaTournament);
+            p2Idx = tournamentSelect(population, cfg.eaTournament);
         }
-        child[pos] = val;
-    }
-    // Uzupełnij puste miejsca kolejnością z p2.
-    for (int i = 0; i < n; ++i) {
-        if (child[i] == -1) {
-            for (int j = 0; j < n; ++j) {
-                int candidate = p2[j];
-                if (!contains(candidate)) {
-                    child[i] = candidate;
-                    break;
-                }
+        {
+            VRP_PHASE(Crossover);
+            const int* parent1 = population.row(p1Idx);
+            if (randUnit() < cfg.eaCrossoverRate) {
+                Crossover::apply(problem, parent1, population.row(p2Idx), genes, work.child, work.crossoverWork);
+                hash = permutationHash(work.child.data(), genes);
+                copied = false;
+            } else {
+                work.child.assign(parent1, parent1 + genes);
+                hash = population.hash(p1Idx);
+                copied = true;
             }
         }
+        {
+            VRP_PHASE(Mutation);
+            if (Mutation::apply(work.child, hash, cfg.eaMutationRate)) copied = false;
+        }
+        if (cfg.eaTwoOptRate > 0.0 && randUnit() < cfg.eaTwoOptRate) {
+            VRP_PHASE(LocalSearch);
+            EducationContext education{problem, work.localSearch.get(), work.routes, lsStrategy, decoder};
+            if (Education::apply(work.child, hash, education)) {
+                copied = false;
+                routed = Education::kRoutes && !Decoding::kKeepsRoutes;
+            }
+        }
+        if (!cfg.eaRejectDuplicates || attempt == kDuplicateAttempts || !inPopulation(hash)) break;
+        ++work.duplicates;
     }
-    return child;
+
+    VRP_PHASE(Decode);
+    ++work.children;
+    double cost;
+    if (copied) {
+        cost = population.cost(p1Idx);
+        ++work.cacheHits;
+    } else if (routed) {
+        // Dekodowanie sklejonej permutacji nie odtworzyłoby tras LS, więc bez dekodowania i oceny wsadowej.
+        cost = work.routes.cost;
+        if (cache.enabled()) cache.store(hash, cost);
+        if (cost < work.bestRoutes.cost) {
+            work.bestRoutes = work.routes;
+            work.bestRoutes.perm = work.child;  // permutacja tras jest już w child (swap w RouteEducation)
+        }
+    } else if (cache.enabled() && cache.lookup(hash, cost)) {
+        ++work.cacheHits;
+    } else if (Decoding::kBatchable && batched) {
+        // Koszt policzy flushBatch; dziecko o skrócie już czekającego dostaje jego koszt, tak jak
+        // z pamięci, do której przy ocenie pojedynczo trafiłby koszt poprzednika.
+        nextPop.assign(slot, work.child.data(), 0.0, hash);
+        if (cache.enabled()) {
+            auto same = std::find(work.pendingHashes.begin(), work.pendingHashes.end(), hash);
+            if (same != work.pendingHashes.end()) {
+                work.aliases.emplace_back(slot, work.pending[same - work.pendingHashes.begin()]);
+                ++work.cacheHits;
+                return;
+            }
+        }
+        work.pending.push_back(slot);
+        work.pendingHashes.push_back(hash);
+        return;
+    } else {
+        cost = Decoding::cost(problem, work.child, decoder);
+        if (cache.enabled()) cache.store(hash, cost);
+    }
+    nextPop.assign(slot, work.child.data(), cost, hash);
 }
 
-// Krzyżowanie cyklowe (CX): buduje cykl pozycji z rodziców.
-static std::vector<int> cycleCrossover(const std::vector<int>& p1, const std::vector<int>& p2) {
-    int n = static_cast<int>(p1.size());
-    std::vector<int> child(n, -1);
-    std::vector<bool> visited(n, false);
-    bool takeFromP1 = true;
-    int start = 0;
-    while (std::find(visited.begin(), visited.end(), false) != visited.end()) {
-        // Znajdź pierwszy nieodwiedzony indeks.
-        while (start < n && visited[start]) ++start;
-        int idx = start;
-        // Przejdź cykl.
-        do {
-            visited[idx] = true;
-            child[idx] = takeFromP1 ? p1[idx] : p2[idx];
-            int val = p1[idx];
-            idx = static_cast<int>(std::find(p2.begin(), p2.end(), val) - p2.begin());
-        } while (idx != start);
-        takeFromP1 = !takeFromP1;
-    }
-    return child;
+Solution EvolutionRun::bestSolution() const {
+    // Każdy koszt w populacji pochodzi z dekodowania albo z tras LS, a najtańsze z tych tras są
+    // w bestRoutes, więc trasy są rozwiązaniem najlepszego, gdy nie są od niego droższe.
+    const Solution* routes = nullptr;
+    for (const EaScratch& work : scratch) {
+        if (!routes || work.bestRoutes.cost < routes->cost) routes = &work.bestRoutes;
+    }
+    if (routes && routes->cost <= bestOverall.cost) return *routes;
+    return decodePermutation(problem, bestOverall.perm, decoder);
 }
 
-// Mutacja swap z prawdopodobieństwem Pm.
-static void mutateSwap(std::vector<int>& perm, double mutationRate) {
-    if (perm.size() < 2) return;
-    if (randUnit() < mutationRate) {
-        int i = randInt(0, static_cast<int>(perm.size()) - 1);
-        int j = randInt(0, static_cast<int>(perm.size()) - 1);
-        while (j == i) j = randInt(0, static_cast<int>(perm.size()) - 1);
-        std::swap(perm[i], perm[j]);
+void EvolutionRun::flushBatch(EaScratch& work) {
+    if (work.pending.empty()) return;
+    VRP_PHASE(Decode);
+    const int count = static_cast<int>(work.pending.size());
+    const int genes = nextPop.genes();
+    work.offsets.resize(count);
+    work.costs.resize(count);
+    for (int k = 0; k < count; ++k) work.offsets[k] = work.pending[k] * genes;
+    evaluateBatch(problem, nextPop.row(0), work.offsets.data(), count, genes, work.costs.data());
+    for (int k = 0; k < count; ++k) {
+        nextPop.cost(work.pending[k]) = work.costs[k];
+        if (cache.enabled()) cache.store(work.pendingHashes[k], work.costs[k]);
     }
+    for (const auto& [slot, source] : work.aliases) nextPop.cost(slot) = nextPop.cost(source);
+    work.pending.clear();
+    work.pendingHashes.clear();
+    work.aliases.clear();
 }
 
-// Mutacja inwersji: odwraca losowy podciąg permutacji.
-static void mutateInversion(std::vector<int>& perm, double mutationRate) {
-    if (perm.size() < 2) return;
-    if (randUnit() < mutationRate) {
-        int a = randInt(0, static_cast<int>(perm.size()) - 1);
-        int b = randInt(0, static_cast<int>(perm.size()) - 1);
-        if (a > b) std::swap(a, b);
-        std::reverse(perm.begin() + a, perm.begin() + b + 1);
+GenerationStats EvolutionRun::evaluateGeneration() {
+    double bestCost = std::numeric_limits<double>::infinity();
+    double worstCost = -std::numeric_limits<double>::infinity();
+    double sumCost = 0.0;
+    int bestIdx = 0;
+    for (int i = 0; i < population.size(); ++i) {
+        double cost = population.cost(i);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestIdx = i;
+        }
+        worstCost = std::max(worstCost, cost);
+        sumCost += cost;
     }
+    double avgCost = sumCost / static_cast<double>(population.size());
+    generationBest = bestIdx;
+    if (bestCost < bestOverall.cost) {
+        // assign w istniejący wektor - bez alokacji.
+        bestOverall.perm.assign(population.row(bestIdx), population.row(bestIdx) + population.genes());
+        bestOverall.cost = bestCost;
+        budget.markBest(bestCost);
+    }
+    return GenerationStats{bestCost, avgCost, worstCost, lastHitRate, lastDuplicates};
 }
 
-// Lokalna poprawa 2-opt: jedna losowa zamiana dwóch krawędzi jeśli poprawia wynik.
-static void twoOptOnce(std::vector<int>& perm, const Problem& problem) {
-    int n = static_cast<int>(perm.size());
-    if (n < 4) return;
-    int i = randInt(0, n - 2);
-    int k = randInt(i + 1, n - 1);
-    // Oblicz koszt fragmentu przed/po 2-opt (w permutacji; dekoder doda depo później).
-    auto edgeCost = [&](int aIdx, int bIdx) {
-        int aNode = perm[aIdx];
-        int bNode = perm[bIdx];
-        return problem.distances[aNode][bNode];
+const std::vector<int>& EvolutionRun::rankBest(int count) {
+    for (int i = 0; i < population.size(); ++i) order[i] = i;
+    auto better = [this](int a, int b) {
+        return population.cost(a) < population.cost(b) || (population.cost(a) == population.cost(b) && a < b);
     };
-    double before = 0.0;
-    double after = 0.0;
-    if (i > 0) {
-        before += edgeCost(i - 1, i);
-        after += edgeCost(i - 1, k);
-    }
-    if (k + 1 < n) {
-        before += edgeCost(k, k + 1);
-        after += edgeCost(i, k + 1);
+    if (count <= 0) return order;
+    if (count < population.size()) std::nth_element(order.begin(), order.begin() + count - 1, order.end(), better);
+    std::sort(order.begin(), order.begin() + count, better);
+    return order;
+}
+
+void EvolutionRun::advance(int gen) {
+    const int popSize = population.size();
+    int elites = std::min(cfg.eaElites, popSize);
+    const std::vector<int>& ranked = rankBest(elites);
+    for (int e = 0; e < elites; ++e) nextPop.copyFrom(e, population, ranked[e]);
+    if (cfg.eaRejectDuplicates) {
+        sortedHashes.resize(popSize);
+        for (int i = 0; i < popSize; ++i) sortedHashes[i] = population.hash(i);
+        std::sort(sortedHashes.begin(), sortedHashes.end());
     }
-    // Środek segmentu.
-    for (int t = i; t < k; ++t) {
-        before += edgeCost(t, t + 1);
-        after += edgeCost(t + 1, t);
+    for (auto& work : scratch) work.children = work.cacheHits = work.duplicates = 0;
+
+    if (!pool) {
+        // Przy ocenie wsadowej dzieci powstają blokami po kEaBatch, oceniane po każdym bloku.
+        const int block = batched ? kEaBatch : popSize;
+        for (int begin = elites; begin < popSize; begin += block) {
+            {
+                VRP_PHASE_REGION();
+                (this->*breed)(begin, std::min(popSize, begin + block), scratch[0]);
+            }
+            flushBatch(scratch[0]);
+        }
+    } else {
+        // Fragmenty po kEaChunk dzieci; każdy ze strumieniem losowym z (pokolenie, fragment).
+        int chunks = (popSize - elites + kEaChunk - 1) / kEaChunk;
+        pool->parallelFor(chunks, [&](int chunk) {
+            ScopedRngStream stream(deriveSubstreamSeed(streamBase, static_cast<std::uint64_t>(gen),
+                                                       static_cast<std::uint64_t>(chunk)));
+            EaScratch& work = scratch[ThreadPool::workerIndex()];
+            WorkerMetrics metricsScope(metrics, metricsMutex);
+            {
+                VRP_PHASE_REGION();
+                int begin = elites + chunk * kEaChunk;
+                int end = std::min(popSize, begin + kEaChunk);
+                (this->*breed)(begin, end, work);
+            }
+            flushBatch(work);
+        });
     }
-    if (after + 1e-9 < before) {
-        std::reverse(perm.begin() + i, perm.begin() + k + 1);
+    long long children = 0, hits = 0;
+    lastDuplicates = 0;
+    for (const auto& work : scratch) {
+        children += work.children;
+        hits += work.cacheHits;
+        lastDuplicates += work.duplicates;
     }
+    lastHitRate = children > 0 ? static_cast<double>(hits) / static_cast<double>(children) : 0.0;
+    budget.spend(children - hits);
+    population.swap(nextPop);
 }
 
-// Selekcja turniejowa, zwraca indeks najlepszego z wylosowanych kandydatów.
-static int tournamentSelect(const std::vector<Individual>& pop, int tourSize) {
-    int bestIdx = -1;
-    double bestCost = std::numeric_limits<double>::infinity();
-    for (int i = 0; i < tourSize; ++i) {
-        int idx = randInt(0, static_cast<int>(pop.size()) - 1);
-        if (pop[idx].cost < bestCost) {
-            bestCost = pop[idx].cost;
-            bestIdx = idx;
+double EvolutionRun::diversity() {
+    const int genes = population.genes();
+    if (genes < 2) return 0.0;
+    bestNext.assign(problem.dimension + 1, -1);
+    bestPrev.assign(problem.dimension + 1, -1);
+    const int* best = population.row(generationBest);
+    for (int i = 0; i + 1 < genes; ++i) {
+        bestNext[best[i]] = best[i + 1];
+        bestPrev[best[i + 1]] = best[i];
+    }
+    long long shared = 0;
+    for (int r = 0; r < population.size(); ++r) {
+        const int* row = population.row(r);
+        for (int i = 0; i + 1 < genes; ++i) {
+            shared += bestNext[row[i]] == row[i + 1] || bestPrev[row[i]] == row[i + 1];
         }
     }
-    return bestIdx;
+    return 1.0 - static_cast<double>(shared) / (static_cast<double>(genes - 1) * population.size());
 }
 
-// Algorytm ewolucyjny: inicjalizacja losowa, turniej, OX, mutacja swap, elity.
-Solution runEvolutionary(const Problem& problem, const Config& cfg, CSVLogger& logger) {
-    const std::string crossoverType = toLowerCopy(cfg.eaCrossoverType);
-    const std::string mutationType = toLowerCopy(cfg.eaMutationType);
-    auto crossoverFn = [&](const std::vector<int>& p1, const std::vector<int>& p2) {
-        if (crossoverType == "pmx") return pmxCrossover(p1, p2);
-        if (crossoverType == "cx" || crossoverType == "cycle") return cycleCrossover(p1, p2);
-        // Domyślnie OX.
-        return orderedCrossover(p1, p2);
-    };
-    auto mutationFn = [&](std::vector<int>& perm) {
-        if (mutationType == "inversion" || mutationType == "inv") mutateInversion(perm, cfg.eaMutationRate);
-        else mutateSwap(perm, cfg.eaMutationRate);
-    };
-    auto localImprove = [&](std::vector<int>& perm) {
-        if (cfg.eaTwoOptRate > 0.0 && randUnit() < cfg.eaTwoOptRate) {
-            twoOptOnce(perm, problem);
-        }
-    };
+void EvolutionRun::emigrants(int count, std::vector<Individual>& out) {
+    count = std::min(count, population.size());
+    const std::vector<int>& ranked = rankBest(count);
+    out.resize(count);
+    for (int i = 0; i < count; ++i) {
+        out[i].perm.assign(population.row(ranked[i]), population.row(ranked[i]) + population.genes());
+        out[i].cost = population.cost(ranked[i]);
+    }
+}
 
-    std::vector<Individual> population;
-    population.reserve(cfg.eaPopulation);
-    int greedyCount = static_cast<int>(std::round(cfg.eaGreedyInitFraction * cfg.eaPopulation));
-    int startId = 2;
-    for (int i = 0; i < cfg.eaPopulation; ++i) {
-        std::vector<int> perm;
-        if (i < greedyCount) {
-            perm = buildGreedyPermutation(problem, startId);
-            startId = 2 + ((startId - 1) % (problem.dimension - 1));
-        } else {
-            perm = randomPermutation(problem);
-        }
-        Solution sol = decodePermutation(problem, perm);
-        population.push_back(Individual{perm, sol.cost});
+void EvolutionRun::immigrate(const std::vector<Individual>& migrants) {
+    int count = std::min(static_cast<int>(migrants.size()), population.size());
+    // Najgorsi to ostatni w kolejności rankBest(rozmiar populacji).
+    const std::vector<int>& ranked = rankBest(population.size());
+    for (int i = 0; i < count; ++i) {
+        const std::vector<int>& perm = migrants[i].perm;
+        population.assign(ranked[population.size() - 1 - i], perm.data(), migrants[i].cost,
+                          permutationHash(perm.data(), population.genes()));
     }
-    Individual bestOverall = population[0];
-    for (const auto& ind : population) if (ind.cost < bestOverall.cost) bestOverall = ind;
+}
 
-    for (int gen = 0; gen < cfg.eaGenerations; ++gen) {
-        double bestCost = std::numeric_limits<double>::infinity();
-        double worstCost = -std::numeric_limits<double>::infinity();
-        double sumCost = 0.0;
-        for (const auto& ind : population) {
-            bestCost = std::min(bestCost, ind.cost);
-            worstCost = std::max(worstCost, ind.cost);
-            sumCost += ind.cost;
+// Skrzynka na migrantów: wysyłający podmienia wskaźnik atomowo (najnowsza paczka wygrywa,
+// niewyjęta starsza jest zwalniana), odbierający wyjmuje go przez exchange(nullptr). Bez blokad.
+class MigrationMailbox {
+  public:
+    ~MigrationMailbox() { delete slot.exchange(nullptr); }
+
+    void post(std::vector<Individual> migrants) {
+        auto* batch = new std::vector<Individual>(std::move(migrants));
+        delete slot.exchange(batch, std::memory_order_acq_rel);
+    }
+
+    std::unique_ptr<std::vector<Individual>> take() {
+        return std::unique_ptr<std::vector<Individual>>(slot.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+  private:
+    std::atomic<std::vector<Individual>*> slot{nullptr};
+};
+
+// Model wyspowy: ea_islands populacji na osobnych wątkach, co ea_migration_interval pokoleń
+// najlepsi osobnicy trafiają do skrzynki sąsiada (ring) lub losowej wyspy (random).
+// Wyspy nie czekają na siebie, więc wynik zależy od przeplotu wątków. Każda wyspa dostaje
+// równą część budżetu ocen (i wspólny termin) oraz własne warunki stopu; osiągnięcie celu na jednej
+// wyspie zatrzymuje wszystkie. Log globalny obejmuje pokolenia wykonane przez wszystkie wyspy.
+static Solution runIslands(const Problem& problem, const Config& cfg, DecoderType decoder, CSVLogger& logger,
+                           Budget& budget) {
+    const int islands = cfg.eaIslands;
+    const int generations = cfg.eaGenerations;
+    const bool randomTopology = toLowerCopy(cfg.eaTopology) == "random";
+    const std::uint64_t streamBase = threadRng()();
+    std::vector<MigrationMailbox> mailboxes(islands);
+    std::vector<std::vector<GenerationStats>> history(islands, std::vector<GenerationStats>(generations));
+    std::vector<Solution> solutions(islands);
+    std::vector<Budget> budgets(islands, budget.share(islands));
+    std::vector<int> generationsDone(islands, 0);
+    std::atomic<bool> targetReached{false};
+
+    RunMetrics* metrics = currentMetrics();
+    std::mutex metricsMutex;
+    ThreadPool pool(islands);
+    pool.parallelFor(islands, [&](int island) {
+        ScopedRngStream stream(deriveSubstreamSeed(streamBase, static_cast<std::uint64_t>(island), 0));
+        WorkerMetrics metricsScope(metrics, metricsMutex);
+        std::unique_ptr<CSVLogger> islandLogger =
+            openSideLog(logger, "_island_" + std::to_string(island), kEaLogHeader);
+        EvolutionRun run(problem, cfg, decoder, 1, budgets[island]);
+        std::vector<Individual> outgoing;
+        for (int gen = 0; gen < generations; ++gen) {
+            GenerationStats stats = run.evaluateGeneration();
+            history[island][gen] = stats;
+            generationsDone[island] = gen + 1;
+            {
+                VRP_PHASE(Logging);
+                islandLogger->log(gen, stats.best, stats.avg, stats.worst, stats.cacheHitRate, stats.duplicates);
+            }
+            Budget& islandBudget = budgets[island];
+            if (cfg.eaStopDiversity > 0.0 && run.diversity() < cfg.eaStopDiversity) {
+                islandBudget.stop(StopReason::Diversity);
+            }
+            if (islandBudget.stopReason() == StopReason::Target) targetReached.store(true, std::memory_order_relaxed);
+            if (targetReached.load(std::memory_order_relaxed)) islandBudget.stop(StopReason::Target);
+            if (islandBudget.step()) break;
+            if (islands > 1 && gen > 0 && cfg.eaMigrationInterval > 0 && gen % cfg.eaMigrationInterval == 0) {
+                int target = (island + 1) % islands;
+                if (randomTopology) {
+                    target = randInt(0, islands - 2);
+                    if (target >= island) ++target;
+                }
+                run.emigrants(cfg.eaMigrationSize, outgoing);
+                mailboxes[target].post(outgoing);
+                if (auto incoming = mailboxes[island].take()) run.immigrate(*incoming);
+            }
+            run.advance(gen);
         }
-        double avgCost = sumCost / static_cast<double>(population.size());
-        logger.logRow(std::to_string(gen) + "," + std::to_string(bestCost) + "," +
-                      std::to_string(avgCost) + "," + std::to_string(worstCost));
-        if (bestCost < bestOverall.cost) {
-            for (const auto& ind : population) if (ind.cost == bestCost) { bestOverall = ind; break; }
+        solutions[island] = run.bestSolution();
+    });
+
+    // Wiersz globalny: najlepszy/najgorszy ze wszystkich wysp, średnia z równolicznych wysp
+    // (także trafień pamięci), suma odrzuconych duplikatów.
+    const int logged = *std::min_element(generationsDone.begin(), generationsDone.end());
+    for (int gen = 0; gen < logged; ++gen) {
+        GenerationStats global{std::numeric_limits<double>::infinity(), 0.0,
+                               -std::numeric_limits<double>::infinity(), 0.0, 0};
+        for (int island = 0; island < islands; ++island) {
+            const GenerationStats& stats = history[island][gen];
+            global.best = std::min(global.best, stats.best);
+            global.worst = std::max(global.worst, stats.worst);
+            global.avg += stats.avg / islands;
+            global.cacheHitRate += stats.cacheHitRate / islands;
+            global.duplicates += stats.duplicates;
         }
+        logger.log(gen, global.best, global.avg, global.worst, global.cacheHitRate, global.duplicates);
+    }
+    // Migrant z kosztem tras LS ma trasy tylko na wyspie, z której przyszedł, więc wynik to najtańsze
+    // z rozwiązań wysp.
+    int bestIsland = 0;
+    for (int island = 1; island < islands; ++island) {
+        if (solutions[island].cost < solutions[bestIsland].cost) bestIsland = island;
+    }
+    for (int island = 0; island < islands; ++island) budget.absorb(budgets[island], islands, island == bestIsland);
+    return std::move(solutions[bestIsland]);
+}
 
-        std::vector<Individual> newPop;
-        newPop.reserve(cfg.eaPopulation);
-        std::vector<Individual> sortedPop = population;
-        std::sort(sortedPop.begin(), sortedPop.end(), [](const Individual& a, const Individual& b) {
-            return a.cost < b.cost;
-        });
-        int elites = std::min(cfg.eaElites, static_cast<int>(sortedPop.size()));
-        for (int e = 0; e < elites; ++e) newPop.push_back(sortedPop[e]);
-
-        while (static_cast<int>(newPop.size()) < cfg.eaPopulation) {
-            int p1Idx = tournamentSelect(population, cfg.eaTournament);
-            int p2Idx = tournamentSelect(population, cfg.eaTournament);
-            const auto& parent1 = population[p1Idx].perm;
-            const auto& parent2 = population[p2Idx].perm;
-            std::vector<int> childPerm;
-            if (randUnit() < cfg.eaCrossoverRate) childPerm = crossoverFn(parent1, parent2);
-            else childPerm = parent1;
-            mutationFn(childPerm);
-            localImprove(childPerm);
-            Solution childSol = decodePermutation(problem, childPerm);
-            newPop.push_back(Individual{childPerm, childSol.cost});
+// Algorytm ewolucyjny: turniej, krzyżowanie, mutacja, opcjonalne 2-opt, elity; dla ea_islands > 1 model wyspowy.
+Solution runEvolutionary(const Problem& problem, const Config& cfg, CSVLogger& logger, Budget& budget) {
+    const DecoderType decoder = parseDecoderType(cfg.decoder, cfg.splitFleetLimit);
+    if (cfg.eaIslands > 1) return runIslands(problem, cfg, decoder, logger, budget);
+
+    EvolutionRun run(problem, cfg, decoder, cfg.eaThreads, budget);
+    for (int gen = 0; gen < cfg.eaGenerations; ++gen) {
+        GenerationStats stats = run.evaluateGeneration();
+        {
+            VRP_PHASE(Logging);
+            logger.log(gen, stats.best, stats.avg, stats.worst, stats.cacheHitRate, stats.duplicates);
         }
-        population = std::move(newPop);
+        if (cfg.eaStopDiversity > 0.0 && run.diversity() < cfg.eaStopDiversity) budget.stop(StopReason::Diversity);
+        if (budget.step()) break;
+        run.advance(gen);
     }
-    return decodePermutation(problem, bestOverall.perm);
+    return run.bestSolution();
 }
@@ -0,0 +1,160 @@
+// Wsadowa ocena permutacji dekoderem greedy: jądra AVX-512 (16 linii), AVX2 (8 linii) i skalarne.
+#include "BatchEval.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VRP_SIMD_X86 1
+#endif
+
+namespace {
+
+// Dane jądra: macierz int32 wierszami (indeks elementu i * stride + j), zapotrzebowania wg id.
+struct GreedyData {
+    const std::int32_t* dist;
+    int stride;
+    const int* demands;
+    int capacity;
+    int depot;
+};
+
+void greedyScalar(const Problem& problem, const int* base, const int* offsets, int count, int length,
+                  double* costs) {
+    for (int b = 0; b < count; ++b) costs[b] = greedyCost(problem, base + offsets[b], length);
+}
+
+#ifdef VRP_SIMD_X86
+
+#define VRP_AVX2 __attribute__((target("avx2")))
+#define VRP_AVX512 __attribute__((target("avx512f")))
+
+// Linia b przechodzi permutację b; pozycja t jest pobierana gatherem spod base + offsets[b] + t.
+// Na każdym kroku: over = load + demand > capacity; w liniach z over dochodzi powrót prev -> depo
+// (gather z maską), prev staje się depo, a ładunek zaczyna się od zera. Sumy są w double w tej samej
+// kolejności co w greedyCost, więc wyniki są identyczne. Niepełny ostatni blok powtarza permutację
+// pierwszej linii bloku, a nadmiarowe wyniki są pomijane. Gathery mają jawne źródło i pełną maskę
+// (jak w DistanceOracle.cpp - bez fałszywych ostrzeżeń GCC 12).
+VRP_AVX2 inline __m256i gather8i(const int* base, __m256i idx) {
+    return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, idx, _mm256_set1_epi32(-1), 4);
+}
+
+VRP_AVX2 inline void accumulate8(__m256d& lo, __m256d& hi, __m256i values) {
+    lo = _mm256_add_pd(lo, _mm256_cvtepi32_pd(_mm256_castsi256_si128(values)));
+    hi = _mm256_add_pd(hi, _mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)));
+}
+
+VRP_AVX2 void greedyAvx2(const GreedyData& data, const int* base, const int* offsets, int count, int length,
+                         double* costs) {
+    const __m256i capacity = _mm256_set1_epi32(data.capacity);
+    const __m256i depot = _mm256_set1_epi32(data.depot);
+    const __m256i stride = _mm256_set1_epi32(data.stride);
+    const __m256i depotRow = _mm256_mullo_epi32(depot, stride);
+    const int* dist = data.dist;
+    for (int b = 0; b < count; b += 8) {
+        const int lanes = std::min(8, count - b);
+        alignas(32) int starts[8];
+        for (int l = 0; l < 8; ++l) starts[l] = offsets[b + (l < lanes ? l : 0)];
+        const __m256i pos = _mm256_load_si256(reinterpret_cast<const __m256i*>(starts));
+        __m256i prevRow = depotRow;
+        __m256i load = _mm256_setzero_si256();
+        __m256d lo = _mm256_setzero_pd(), hi = _mm256_setzero_pd();
+        for (int t = 0; t < length; ++t) {
+            __m256i customer = gather8i(base + t, pos);
+            __m256i demand = gather8i(data.demands, customer);
+            __m256i next = _mm256_add_epi32(load, demand);
+            __m256i over = _mm256_cmpgt_epi32(next, capacity);
+            __m256i back = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), dist, _mm256_add_epi32(prevRow, depot),
+                                                       over, 4);
+            accumulate8(lo, hi, back);
+            prevRow = _mm256_blendv_epi8(prevRow, depotRow, over);
+            load = _mm256_blendv_epi8(next, demand, over);
+            accumulate8(lo, hi, gather8i(dist, _mm256_add_epi32(prevRow, customer)));
+            prevRow = _mm256_mullo_epi32(customer, stride);
+        }
+        accumulate8(lo, hi, gather8i(dist, _mm256_add_epi32(prevRow, depot)));
+        alignas(32) double sums[8];
+        _mm256_store_pd(sums, lo);
+        _mm256_store_pd(sums + 4, hi);
+        std::copy(sums, sums + lanes, costs + b);
+    }
+}
+
+VRP_AVX512 inline __m512i gather16i(const int* base, __m512i idx) {
+    return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, idx, base, 4);
+}
+
+VRP_AVX512 inline void accumulate16(__m512d& lo, __m512d& hi, __m512i values) {
+    lo = _mm512_add_pd(lo, _mm512_maskz_cvtepi32_pd(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, values, 0)));
+    hi = _mm512_add_pd(hi, _mm512_maskz_cvtepi32_pd(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, values, 1)));
+}
+
+VRP_AVX512 void greedyAvx512(const GreedyData& data, const int* base, const int* offsets, int count, int length,
+                             double* costs) {
+    const __m512i capacity = _mm512_set1_epi32(data.capacity);
+    const __m512i depot = _mm512_set1_epi32(data.depot);
+    const __m512i stride = _mm512_set1_epi32(data.stride);
+    const __m512i depotRow = _mm512_mullo_epi32(depot, stride);
+    const int* dist = data.dist;
+    for (int b = 0; b < count; b += 16) {
+        const int lanes = std::min(16, count - b);
+        alignas(64) int starts[16];
+        for (int l = 0; l < 16; ++l) starts[l] = offsets[b + (l < lanes ? l : 0)];
+        const __m512i pos = _mm512_load_si512(starts);
+        __m512i prevRow = depotRow;
+        __m512i load = _mm512_setzero_si512();
+        __m512d lo = _mm512_setzero_pd(), hi = _mm512_setzero_pd();
+        for (int t = 0; t < length; ++t) {
+            __m512i customer = gather16i(base + t, pos);
+            __m512i demand = gather16i(data.demands, customer);
+            __m512i next = _mm512_add_epi32(load, demand);
+            __mmask16 over = _mm512_cmpgt_epi32_mask(next, capacity);
+            __m512i back = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), over,
+                                                       _mm512_add_epi32(prevRow, depot), dist, 4);
+            accumulate16(lo, hi, back);
+            prevRow = _mm512_mask_blend_epi32(over, prevRow, depotRow);
+            load = _mm512_mask_blend_epi32(over, next, demand);
+            accumulate16(lo, hi, gather16i(dist, _mm512_add_epi32(prevRow, customer)));
+            prevRow = _mm512_mullo_epi32(customer, stride);
+        }
+        accumulate16(lo, hi, gather16i(dist, _mm512_add_epi32(prevRow, depot)));
+        alignas(64) double sums[16];
+        _mm512_store_pd(sums, lo);
+        _mm512_store_pd(sums + 8, hi);
+        std::copy(sums, sums + lanes, costs + b);
+    }
+}
+
+#endif  // VRP_SIMD_X86
+
+}  // namespace
+
+SimdLevel batchSimdLevel(const Problem& problem, SimdLevel level) {
+    const DistanceMatrix* matrix = problem.distances.dense();
+    // Indeksy gatherów (i * stride + j) są 32-bitowe.
+    if (!std::is_same_v<DistanceValue, std::int32_t> || !matrix ||
+        matrix->rowStride() * static_cast<std::size_t>(matrix->size()) >
+            static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        return SimdLevel::Scalar;
+    }
+    return clampSimd(level);
+}
+
+void evaluateBatch(const Problem& problem, const int* base, const int* offsets, int count, int length,
+                   double* costs, SimdLevel level) {
+    level = batchSimdLevel(problem, level);
+#ifdef VRP_SIMD_X86
+    if (level != SimdLevel::Scalar && count > 0) {
+        const DistanceMatrix& matrix = *problem.distances.dense();
+        const GreedyData data{reinterpret_cast<const std::int32_t*>(matrix.row(0)),
+                              static_cast<int>(matrix.rowStride()), problem.demands.data(), problem.capacity,
+                              problem.depotId};
+        if (level == SimdLevel::Avx512) return greedyAvx512(data, base, offsets, count, length, costs);
+        return greedyAvx2(data, base, offsets, count, length, costs);
+    }
+#endif
+    greedyScalar(problem, base, offsets, count, length, costs);
+}
@@ -0,0 +1,102 @@
+#include "Budget.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+// Najdłuższy odstęp (w wywołaniach spend) między odczytami zegara.
+static const int kMaxClockStride = 1 << 14;
+
+// Czas zegara zgrubnego [ms] w skali steady_clock (na Linuksie oba liczą od tej samej chwili).
+static double coarseNowMs() {
+#ifdef __linux__
+    timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0) return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+#endif
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Rozdzielczość zegara zgrubnego [ms] (zwykle 1-4 ms).
+static double coarseTickMs() {
+#ifdef __linux__
+    timespec ts;
+    if (clock_getres(CLOCK_MONOTONIC_COARSE, &ts) == 0) return std::max(1e-3, ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6);
+#endif
+    return 1e-3;
+}
+
+static const double kTickMs = coarseTickMs();
+
+const char* stopReasonName(StopReason reason) {
+    switch (reason) {
+        case StopReason::Completed: return "completed";
+        case StopReason::TimeBudget: return "time_budget";
+        case StopReason::EvaluationBudget: return "evaluation_budget";
+        case StopReason::Target: return "target";
+        case StopReason::Stagnation: return "stagnation";
+        case StopReason::Diversity: return "diversity";
+    }
+    return "unknown";
+}
+
+Budget::Budget(double limitMs, long long limitEvaluations)
+    : limitMs(std::max(0.0, limitMs)), limitEvaluations(std::max(0LL, limitEvaluations)),
+      start(std::chrono::steady_clock::now()), targetCost(-std::numeric_limits<double>::infinity()) {}
+
+void Budget::pollClock() {
+    double now = coarseNowMs() - std::chrono::duration<double, std::milli>(start.time_since_epoch()).count();
+    if (now >= limitMs - 2.0 * kTickMs) {
+        // Ostatnie ticki przed terminem: dokładny zegar i coraz częstsze odczyty.
+        now = elapsedMs();
+        clockStride = std::max(1, clockStride / 4);
+    } else if (now == lastClockMs) {
+        // Zegar stoi od ostatniego odczytu - czytamy za często.
+        clockStride = std::min(clockStride * 2, kMaxClockStride);
+    } else if (now - lastClockMs > kTickMs && clockStride > 1) {
+        // Minął więcej niż jeden tick - za rzadko.
+        clockStride /= 2;
+    }
+    untilClock = clockStride;
+    lastClockMs = now;
+    if (now >= limitMs) stop(StopReason::TimeBudget);
+}
+
+double Budget::fraction() const {
+    double part = 0.0;
+    if (limitMs > 0.0) part = std::max(part, lastClockMs / limitMs);
+    if (limitEvaluations > 0) part = std::max(part, static_cast<double>(used) / static_cast<double>(limitEvaluations));
+    return std::min(part, 1.0);
+}
+
+double Budget::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Budget::markBest(double cost) {
+    bestMs = elapsedMs();
+    bestEvaluations = used;
+    bestStep = steps;
+    if (cost <= targetCost) stop(StopReason::Target);
+}
+
+Budget Budget::share(int parts) const {
+    Budget part(limitMs, limitEvaluations > 0 ? std::max(1LL, limitEvaluations / std::max(1, parts)) : 0);
+    part.start = start;
+    part.targetCost = targetCost;
+    part.stagnationLimit = stagnationLimit;
+    return part;
+}
+
+void Budget::absorb(const Budget& part, int parts, bool bestHere) {
+    used += part.used;
+    if (bestHere) {
+        bestMs = part.bestMs;
+        bestEvaluations = part.bestEvaluations * std::max(1, parts);
+        steps = part.steps;
+        bestStep = part.bestStep;
+        if (part.stopped) stop(part.reason);
+    }
+}
@@ -1,10 +1,12 @@
 // Prosty loader konfiguracji z pliku key=value.
 #include "Config.h"
 
+#include <algorithm>
 #include <cctype>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 static std::string trim(const std::string& text) {
     size_t start = 0;
@@ -14,6 +16,32 @@ static std::string trim(const std::string& text) {
     return text.substr(start, end - start);
 }
 
+// Liczba wątków puli dla nastawy (0 - liczba rdzeni), jak w konstruktorze ThreadPool.
+static int poolThreads(int setting, int cores) {
+    return setting > 0 ? setting : cores;
+}
+
+std::vector<std::string> configWarnings(const Config& cfg) {
+    std::vector<std::string> warnings;
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int runThreads = poolThreads(cfg.threads, cores);
+    if (cfg.eaRuns > 0 && cfg.eaThreads != 1) {
+        const long long total = static_cast<long long>(runThreads) * poolThreads(cfg.eaThreads, cores);
+        if (total > cores) {
+            warnings.push_back("threads x ea_threads = " + std::to_string(total) + " przekracza liczbę rdzeni (" +
+                               std::to_string(cores) + "); pula EA powstaje w każdym równoległym runie");
+        }
+    }
+    if (cfg.saRuns > 0 && cfg.saReplicas > 1) {
+        const long long total = static_cast<long long>(runThreads) * cfg.saReplicas;
+        if (total > cores) {
+            warnings.push_back("threads x sa_replicas = " + std::to_string(total) + " przekracza liczbę rdzeni (" +
+                               std::to_string(cores) + "); każdy run SA ma własny wątek na replikę");
+        }
+    }
+    return warnings;
+}
+
 Config ConfigLoader::load(const std::string& path) {
     readFile(path);
     return buildConfig(path);
@@ -56,6 +84,11 @@ Config ConfigLoader::buildConfig(const std::string& path) {
     cfg.saMinTemp = getDouble("sa_min_temp", 0.01);
     cfg.saCoolingRate = getDouble("sa_cooling_rate", 0.995);
     cfg.saIterations = getInt("sa_iterations_per_temp", 200);
+    cfg.saAutoCooling = getBool("sa_auto_cooling", true);
+    cfg.saReplicas = getInt("sa_replicas", 1);
+    cfg.saLadder = getString("sa_ladder", "geometric");
+    cfg.saExchangeInterval = getInt("sa_exchange_interval", 100);
+    cfg.saTargetSwapRate = getDouble("sa_target_swap_rate", 0.23);
     cfg.eaPopulation = getInt("ea_population", 100);
     cfg.eaGenerations = getInt("ea_generations", 100);
     cfg.eaCrossoverRate = getDouble("ea_crossover_rate", 0.7);
@@ -66,6 +99,37 @@ Config ConfigLoader::buildConfig(const std::string& path) {
     cfg.eaMutationType = getString("ea_mutation_type", "inversion");
     cfg.eaGreedyInitFraction = getDouble("ea_greedy_init_fraction", 0.0);
     cfg.eaTwoOptRate = getDouble("ea_two_opt_rate", 0.0);
+    cfg.eaThreads = getInt("ea_threads", 1);
+    cfg.eaIslands = getInt("ea_islands", 1);
+    cfg.eaMigrationInterval = getInt("ea_migration_interval", 50);
+    cfg.eaMigrationSize = getInt("ea_migration_size", 2);
+    cfg.eaTopology = getString("ea_topology", "ring");
+    cfg.eaLocalSearch = getString("ea_local_search", "two_opt");
+    cfg.eaCacheSize = getInt("ea_cache_size", 65536);
+    cfg.eaRejectDuplicates = getBool("ea_reject_duplicates", false);
+    cfg.lsStrategy = getString("ls_strategy", "first");
+    cfg.saLocalSearch = getBool("sa_local_search", false);
+    cfg.decoder = getString("decoder", "greedy");
+    cfg.splitFleetLimit = getBool("split_fleet_limit", false);
+    cfg.batchEvaluation = getBool("batch_evaluation", true);
+    cfg.seed = std::stoull(getString("seed", "0"));
+    cfg.threads = getInt("threads", 1);
+    cfg.candidates = getInt("candidates", 16);
+    cfg.distanceMode = getString("distance_mode", "auto");
+    cfg.distanceDenseLimitMb = getDouble("distance_dense_limit_mb", 1024.0);
+    cfg.logFormat = getString("log_format", "csv");
+    cfg.logMode = getString("log_mode", "per_run");
+    cfg.rawLogRuns = getInt("raw_log_runs", 1);
+    cfg.logPolicy = getString("log_policy", "all");
+    cfg.logEvery = getInt("log_every", 100);
+    cfg.aggregatePoints = getInt("aggregate_points", 1000);
+    cfg.runMetrics = getBool("run_metrics", true);
+    cfg.perfCounters = getBool("perf_counters", false);
+    cfg.budgetMs = getDouble("budget_ms", 0.0);
+    cfg.budgetEvaluations = std::stoll(getString("budget_evaluations", "0"));
+    cfg.stopTargetGap = getDouble("stop_target_gap", -1.0);
+    cfg.stopStagnation = getInt("stop_stagnation", 0);
+    cfg.eaStopDiversity = getDouble("ea_stop_diversity", 0.0);
     cfg.verbose = getBool("verbose", true);
     return cfg;
 }
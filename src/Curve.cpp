@@ -0,0 +1,54 @@
+#include "Curve.h"
+
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+CurveAggregator::CurveAggregator(int runs, int stride)
+    : sampleStride(stride), waiting(runs), ready(runs, 0) {}
+
+void CurveAggregator::submit(int run, std::vector<double> curve) {
+    std::lock_guard<std::mutex> lock(mutex);
+    waiting[run] = std::move(curve);
+    ready[run] = 1;
+    while (nextRun < static_cast<int>(ready.size()) && ready[nextRun]) {
+        consume(waiting[nextRun]);
+        std::vector<double>().swap(waiting[nextRun]);
+        ++nextRun;
+    }
+}
+
+void CurveAggregator::consume(const std::vector<double>& curve) {
+    if (curve.size() > points.size()) points.resize(curve.size());
+    for (size_t i = 0; i < curve.size(); ++i) {
+        Point& point = points[i];
+        point.stats.add(curve[i]);
+        point.q10.add(curve[i]);
+        point.median.add(curve[i]);
+        point.q90.add(curve[i]);
+    }
+}
+
+bool CurveAggregator::write(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Nie można otworzyć pliku krzywej: " << path << "\n";
+        return false;
+    }
+    out << "step,runs,mean,std,min,max,q10,median,q90\n";
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Point& point = points[i];
+        out << i * static_cast<size_t>(sampleStride) << "," << point.stats.count << ","
+            << std::to_string(point.stats.mean) << "," << std::to_string(point.stats.stddev()) << ","
+            << std::to_string(point.stats.min) << "," << std::to_string(point.stats.max) << ","
+            << std::to_string(point.q10.value()) << "," << std::to_string(point.median.value()) << ","
+            << std::to_string(point.q90.value()) << "\n";
+    }
+    return true;
+}
+
+int curveStride(long long steps, int maxPoints) {
+    if (maxPoints <= 0 || steps <= maxPoints) return 1;
+    return static_cast<int>((steps + maxPoints - 1) / maxPoints);
+}
@@ -0,0 +1,292 @@
+// Tryb odległości na żądanie: jądra wiersza, zbierania (gather) i długości trasy w wersjach AVX-512,
+// AVX2 i skalarnej, wybieranych raz według CPUID, oraz pamięć podręczna wierszy każdego wątku.
+#include "DistanceOracle.h"
+
+#include "Simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VRP_SIMD_X86 1
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Zaokrąglenie jak przy budowie macierzy (std::round - połówki od zera, std::ceil dla CEIL_2D).
+inline double roundDistance(double dist, bool ceiling) { return ceiling ? std::ceil(dist) : std::round(dist); }
+
+inline double pointDistance(double x0, double y0, double x, double y, bool ceiling) {
+    double dx = x0 - x;
+    double dy = y0 - y;
+    return roundDistance(std::sqrt(dx * dx + dy * dy), ceiling);
+}
+
+void rowScalar(double x0, double y0, const double* xs, const double* ys, int count, DistanceValue* out,
+               bool ceiling) {
+    for (int j = 0; j < count; ++j) out[j] = static_cast<DistanceValue>(pointDistance(x0, y0, xs[j], ys[j], ceiling));
+}
+
+void gatherScalar(double x0, double y0, const double* xs, const double* ys, const int* ids, int count, double* out,
+                  bool ceiling) {
+    for (int k = 0; k < count; ++k) {
+        out[k] = static_cast<DistanceValue>(pointDistance(x0, y0, xs[ids[k]], ys[ids[k]], ceiling));
+    }
+}
+
+double pathScalar(const double* xs, const double* ys, const int* ids, int first, int count, bool ceiling) {
+    double total = 0.0;
+    for (int k = first; k + 1 < count; ++k) {
+        total += static_cast<DistanceValue>(pointDistance(xs[ids[k]], ys[ids[k]], xs[ids[k + 1]], ys[ids[k + 1]], ceiling));
+    }
+    return total;
+}
+
+#ifdef VRP_SIMD_X86
+
+// Jądra wektorowe: mnożenie i dodawanie bez łączenia w FMA (fp-contract=off), żeby suma kwadratów,
+// a więc i zaokrąglona odległość, była identyczna z wersją skalarną.
+#define VRP_AVX2 __attribute__((target("avx2"), optimize("fp-contract=off")))
+#define VRP_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+
+// Warianty intrynsyk z jawnym źródłem/maską: wersje bez maski startują od _mm*_undefined_*, na co
+// GCC 12 zgłasza fałszywe ostrzeżenia -Wmaybe-uninitialized.
+VRP_AVX2 inline __m256d gather4(const double* base, __m128i idx) {
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, all, 8);
+}
+VRP_AVX512 inline __m512d gather8(const double* base, __m256i idx) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, base, 8);
+}
+
+VRP_AVX2 inline __m256d distance4(__m256d x0, __m256d y0, __m256d x, __m256d y, bool ceiling) {
+    __m256d dx = _mm256_sub_pd(x0, x);
+    __m256d dy = _mm256_sub_pd(y0, y);
+    __m256d dist = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    if (ceiling) return _mm256_round_pd(dist, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    // std::round: obcięcie i +1, gdy część ułamkowa >= 0.5 (odległości są nieujemne).
+    __m256d whole = _mm256_round_pd(dist, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256d up = _mm256_cmp_pd(_mm256_sub_pd(dist, whole), _mm256_set1_pd(0.5), _CMP_GE_OQ);
+    return _mm256_add_pd(whole, _mm256_and_pd(up, _mm256_set1_pd(1.0)));
+}
+
+VRP_AVX2 void rowAvx2(double x0, double y0, const double* xs, const double* ys, int count, DistanceValue* out,
+                      bool ceiling) {
+    const __m256d vx = _mm256_set1_pd(x0), vy = _mm256_set1_pd(y0);
+    alignas(32) double lanes[4];
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        _mm256_store_pd(lanes, distance4(vx, vy, _mm256_loadu_pd(xs + j), _mm256_loadu_pd(ys + j), ceiling));
+        for (int l = 0; l < 4; ++l) out[j + l] = static_cast<DistanceValue>(lanes[l]);
+    }
+    rowScalar(x0, y0, xs + j, ys + j, count - j, out + j, ceiling);
+}
+
+VRP_AVX2 void gatherAvx2(double x0, double y0, const double* xs, const double* ys, const int* ids, int count,
+                         double* out, bool ceiling) {
+    const __m256d vx = _mm256_set1_pd(x0), vy = _mm256_set1_pd(y0);
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + k));
+        // Zaokrąglona odległość mieści się dokładnie w DistanceValue, więc rzutowanie można pominąć.
+        _mm256_storeu_pd(out + k, distance4(vx, vy, gather4(xs, idx), gather4(ys, idx), ceiling));
+    }
+    gatherScalar(x0, y0, xs, ys, ids + k, count - k, out + k, ceiling);
+}
+
+VRP_AVX2 double pathAvx2(const double* xs, const double* ys, const int* ids, int count, bool ceiling) {
+    __m256d sum = _mm256_setzero_pd();
+    int k = 0;
+    for (; k + 5 <= count; k += 4) {
+        __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + k));
+        __m128i to = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + k + 1));
+        sum = _mm256_add_pd(sum, distance4(gather4(xs, from), gather4(ys, from), gather4(xs, to), gather4(ys, to), ceiling));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + pathScalar(xs, ys, ids, k, count, ceiling);
+}
+
+VRP_AVX512 inline __m512d distance8(__m512d x0, __m512d y0, __m512d x, __m512d y, bool ceiling) {
+    __m512d dx = _mm512_sub_pd(x0, x);
+    __m512d dy = _mm512_sub_pd(y0, y);
+    __m512d dist = _mm512_maskz_sqrt_pd(0xFF, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+    if (ceiling) return _mm512_maskz_roundscale_pd(0xFF, dist, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    __m512d whole = _mm512_maskz_roundscale_pd(0xFF, dist, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __mmask8 up = _mm512_cmp_pd_mask(_mm512_sub_pd(dist, whole), _mm512_set1_pd(0.5), _CMP_GE_OQ);
+    return _mm512_mask_add_pd(whole, up, whole, _mm512_set1_pd(1.0));
+}
+
+VRP_AVX512 void rowAvx512(double x0, double y0, const double* xs, const double* ys, int count, DistanceValue* out,
+                          bool ceiling) {
+    const __m512d vx = _mm512_set1_pd(x0), vy = _mm512_set1_pd(y0);
+    alignas(64) double lanes[8];
+    for (int j = 0; j < count; j += 8) {
+        // Ostatni niepełny blok przez maskę zamiast pętli skalarnej.
+        const int active = std::min(8, count - j);
+        const __mmask8 mask = static_cast<__mmask8>((1u << active) - 1u);
+        __m512d x = _mm512_maskz_loadu_pd(mask, xs + j);
+        __m512d y = _mm512_maskz_loadu_pd(mask, ys + j);
+        _mm512_store_pd(lanes, distance8(vx, vy, x, y, ceiling));
+        for (int l = 0; l < active; ++l) out[j + l] = static_cast<DistanceValue>(lanes[l]);
+    }
+}
+
+VRP_AVX512 void gatherAvx512(double x0, double y0, const double* xs, const double* ys, const int* ids, int count,
+                             double* out, bool ceiling) {
+    const __m512d vx = _mm512_set1_pd(x0), vy = _mm512_set1_pd(y0);
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + k));
+        __m512d dist = distance8(vx, vy, gather8(xs, idx), gather8(ys, idx), ceiling);
+        _mm512_storeu_pd(out + k, dist);
+    }
+    gatherScalar(x0, y0, xs, ys, ids + k, count - k, out + k, ceiling);
+}
+
+VRP_AVX512 double pathAvx512(const double* xs, const double* ys, const int* ids, int count, bool ceiling) {
+    __m512d sum = _mm512_setzero_pd();
+    int k = 0;
+    for (; k + 9 <= count; k += 8) {
+        __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + k));
+        __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + k + 1));
+        sum = _mm512_add_pd(sum, distance8(gather8(xs, from), gather8(ys, from), gather8(xs, to), gather8(ys, to), ceiling));
+    }
+    // Odległości są całkowite, więc kolejność sumowania nie zmienia wyniku.
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, sum);
+    double total = 0.0;
+    for (double lane : lanes) total += lane;
+    return total + pathScalar(xs, ys, ids, k, count, ceiling);
+}
+
+#endif  // VRP_SIMD_X86
+
+const SimdLevel kSimd = detectedSimd();
+
+// Kilka ostatnio liczonych wierszy (odwzorowanie bezpośrednie po id wiersza).
+constexpr int kRowCacheSlots = 8;
+
+struct RowCache {
+    std::uint64_t keys[kRowCacheSlots] = {};
+    int rows[kRowCacheSlots] = {};
+    AlignedVector<DistanceValue> values[kRowCacheSlots];
+};
+
+std::atomic<std::uint64_t> nextCacheKey{1};
+
+// Dostępna pamięć [B]: MemAvailable z /proc/meminfo, inaczej wolne strony; 0 gdy nieznana.
+double availableMemoryBytes() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    double kilobytes = 0.0;
+    std::string unit;
+    while (meminfo >> key >> kilobytes >> unit) {
+        if (key == "MemAvailable:") return kilobytes * 1024.0;
+    }
+#if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && pageSize > 0) return static_cast<double>(pages) * static_cast<double>(pageSize);
+#endif
+    return 0.0;
+}
+
+}  // namespace
+
+DistanceMode parseDistanceMode(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "dense") return DistanceMode::Dense;
+    if (lower == "on_demand") return DistanceMode::OnDemand;
+    return DistanceMode::Auto;
+}
+
+bool preferDenseDistances(int size, const DistanceSettings& settings) {
+    if (settings.mode != DistanceMode::Auto) return settings.mode == DistanceMode::Dense;
+    constexpr double perLine = static_cast<double>(kCacheLine / sizeof(DistanceValue));
+    const double bytes = std::ceil(size / perLine) * perLine * size * sizeof(DistanceValue);
+    if (bytes > settings.denseLimitMb * 1024.0 * 1024.0) return false;
+    const double available = availableMemoryBytes();
+    return available <= 0.0 || bytes <= available / 2.0;
+}
+
+const char* distanceKernelName() { return simdLevelName(kSimd); }
+
+void DistanceOracle::computeOnDemand(const double* x, const double* y, int size, bool ceil) {
+    matrix = DistanceMatrix();
+    xs.assign(x, x + size);
+    ys.assign(y, y + size);
+    dim = size;
+    ceiling = ceil;
+    onDemandMode = true;
+    cacheKey = nextCacheKey.fetch_add(1, std::memory_order_relaxed);
+    if constexpr (std::is_integral_v<DistanceValue>) {
+        if (size > 0) {
+            auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+            auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+            double longest = std::ceil(std::hypot(*maxX - *minX, *maxY - *minY));
+            if (longest > static_cast<double>(std::numeric_limits<DistanceValue>::max())) {
+                throw std::runtime_error("Odległość " + std::to_string(longest) +
+                                         " nie mieści się w typie elementu macierzy odległości");
+            }
+        }
+    }
+}
+
+const DistanceValue* DistanceOracle::cachedRow(int i) const {
+    thread_local RowCache cache;
+    const int slot = i & (kRowCacheSlots - 1);
+    AlignedVector<DistanceValue>& values = cache.values[slot];
+    if (cache.keys[slot] == cacheKey && cache.rows[slot] == i) return values.data();
+    values.resize(dim);
+    switch (kSimd) {
+#ifdef VRP_SIMD_X86
+        case SimdLevel::Avx512: rowAvx512(xs[i], ys[i], xs.data(), ys.data(), dim, values.data(), ceiling); break;
+        case SimdLevel::Avx2: rowAvx2(xs[i], ys[i], xs.data(), ys.data(), dim, values.data(), ceiling); break;
+#endif
+        default: rowScalar(xs[i], ys[i], xs.data(), ys.data(), dim, values.data(), ceiling); break;
+    }
+    cache.keys[slot] = cacheKey;
+    cache.rows[slot] = i;
+    return values.data();
+}
+
+DistanceValue DistanceOracle::pairOnDemand(int i, int j) const {
+    return static_cast<DistanceValue>(pointDistance(xs[i], ys[i], xs[j], ys[j], ceiling));
+}
+
+void DistanceOracle::gatherOnDemand(int from, const int* ids, int count, double* out) const {
+    switch (kSimd) {
+#ifdef VRP_SIMD_X86
+        case SimdLevel::Avx512: gatherAvx512(xs[from], ys[from], xs.data(), ys.data(), ids, count, out, ceiling); return;
+        case SimdLevel::Avx2: gatherAvx2(xs[from], ys[from], xs.data(), ys.data(), ids, count, out, ceiling); return;
+#endif
+        default: gatherScalar(xs[from], ys[from], xs.data(), ys.data(), ids, count, out, ceiling); return;
+    }
+}
+
+double DistanceOracle::routeOnDemand(int depot, const int* ids, int count) const {
+    if (count == 0) return 0.0;
+    double ends = pairOnDemand(depot, ids[0]) + pairOnDemand(ids[count - 1], depot);
+    switch (kSimd) {
+#ifdef VRP_SIMD_X86
+        case SimdLevel::Avx512: return ends + pathAvx512(xs.data(), ys.data(), ids, count, ceiling);
+        case SimdLevel::Avx2: return ends + pathAvx2(xs.data(), ys.data(), ids, count, ceiling);
+#endif
+        default: return ends + pathScalar(xs.data(), ys.data(), ids, 0, count, ceiling);
+    }
+}
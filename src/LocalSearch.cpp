@@ -0,0 +1,255 @@
+#include "LocalSearch.h"
+
+#include "Random.h"
+
+#include <algorithm>
+#include <string>
+
+// Minimalna poprawa uznawana za ruch poprawiający (chroni przed cyklami na błędach zaokrągleń).
+static const double kLsEpsilon = 1e-9;
+
+LsStrategy parseLsStrategy(const std::string& name) {
+    return name == "best" ? LsStrategy::BestImprovement : LsStrategy::FirstImprovement;
+}
+
+LocalSearch::LocalSearch(const Problem& problem)
+    : problem(problem), routeOf(problem.dimension + 1, -1), posOf(problem.dimension + 1, -1),
+      cumLoad(problem.dimension + 1, 0) {}
+
+void LocalSearch::load(const Solution& solution) {
+    const int n = static_cast<int>(solution.perm.size());
+    const int routeCount = static_cast<int>(solution.routeStarts.size());
+    routes.resize(routeCount);
+    routeLoad.assign(routeCount, 0);
+    for (int r = 0; r < routeCount; ++r) {
+        int begin = solution.routeStarts[r];
+        int end = r + 1 < routeCount ? solution.routeStarts[r + 1] : n;
+        routes[r].assign(solution.perm.begin() + begin, solution.perm.begin() + end);
+        refreshRoute(r);
+    }
+    order.assign(solution.perm.begin(), solution.perm.end());
+}
+
+void LocalSearch::store(Solution& solution) const {
+    solution.perm.clear();
+    solution.routeStarts.clear();
+    for (const auto& route : routes) {
+        if (route.empty()) continue;
+        solution.routeStarts.push_back(static_cast<int>(solution.perm.size()));
+        solution.perm.insert(solution.perm.end(), route.begin(), route.end());
+    }
+    solution.cost = evaluateSolution(problem, solution);
+}
+
+void LocalSearch::refreshRoute(int r) {
+    int loadSoFar = 0;
+    const std::vector<int>& route = routes[r];
+    for (int p = 0; p < static_cast<int>(route.size()); ++p) {
+        int id = route[p];
+        loadSoFar += problem.demands[id];
+        routeOf[id] = r;
+        posOf[id] = p;
+        cumLoad[id] = loadSoFar;
+    }
+    routeLoad[r] = loadSoFar;
+}
+
+// Przeniesienie segmentu 1..3 klientów od u (Or-opt), także odwróconego, za węzeł v.
+void LocalSearch::evaluateRelocate(int ru, int pu, int rv, int pv, Move& best) const {
+    const int lenRoute = static_cast<int>(routes[ru].size());
+    const int a = nodeAt(ru, pu - 1);
+    const int s1 = routes[ru][pu];
+    for (int len = 1; len <= 3 && pu + len <= lenRoute; ++len) {
+        const int last = pu + len - 1;
+        if (ru == rv && pv >= pu - 1 && pv <= last) continue;  // v w segmencie albo tuż przed nim
+        const int sL = routes[ru][last];
+        if (ru != rv) {
+            int segmentLoad = prefixLoad(ru, last) - prefixLoad(ru, pu - 1);
+            if (routeLoad[rv] + segmentLoad > problem.capacity) break;
+        }
+        const int b = nodeAt(ru, last + 1);
+        const int v = nodeAt(rv, pv);
+        const int vn = nodeAt(rv, pv + 1);
+        const double removal = dist(a, b) - dist(a, s1) - dist(sL, b) - dist(v, vn);
+        double delta = removal + dist(v, s1) + dist(sL, vn);
+        if (delta < best.delta) best = Move{MoveType::Relocate, ru, pu, len, rv, pv, 1, false, delta};
+        if (len > 1) {
+            delta = removal + dist(v, sL) + dist(s1, vn);
+            if (delta < best.delta) best = Move{MoveType::Relocate, ru, pu, len, rv, pv, 1, true, delta};
+        }
+    }
+}
+
+// Zamiana segmentów 1..2 klientów zaczynających się od u i od v.
+void LocalSearch::evaluateSwap(int ru, int pu, int rv, int pv, Move& best) const {
+    for (int lenU = 1; lenU <= 2 && pu + lenU <= static_cast<int>(routes[ru].size()); ++lenU) {
+        for (int lenV = 1; lenV <= 2 && pv + lenV <= static_cast<int>(routes[rv].size()); ++lenV) {
+            // W tej samej trasie segmenty nie mogą się stykać (to przypadek relocate).
+            if (ru == rv && pu + lenU >= pv && pv + lenV >= pu) continue;
+            const int lastU = pu + lenU - 1;
+            const int lastV = pv + lenV - 1;
+            if (ru != rv) {
+                int loadU = prefixLoad(ru, lastU) - prefixLoad(ru, pu - 1);
+                int loadV = prefixLoad(rv, lastV) - prefixLoad(rv, pv - 1);
+                if (routeLoad[ru] - loadU + loadV > problem.capacity ||
+                    routeLoad[rv] - loadV + loadU > problem.capacity) {
+                    continue;
+                }
+            }
+            const int pa = nodeAt(ru, pu - 1), a1 = routes[ru][pu], aL = routes[ru][lastU], na = nodeAt(ru, lastU + 1);
+            const int pb = nodeAt(rv, pv - 1), b1 = routes[rv][pv], bL = routes[rv][lastV], nb = nodeAt(rv, lastV + 1);
+            double delta = dist(pa, b1) + dist(bL, na) + dist(pb, a1) + dist(aL, nb) -
+                           dist(pa, a1) - dist(aL, na) - dist(pb, b1) - dist(bL, nb);
+            if (delta < best.delta) best = Move{MoveType::Swap, ru, pu, lenU, rv, pv, lenV, false, delta};
+        }
+    }
+}
+
+// 2-opt w jednej trasie: odwrócenie fragmentu między u i v (krawędź u-v zamiast u-następnik).
+void LocalSearch::evaluateTwoOpt(int r, int pu, int pv, Move& best) const {
+    int i = std::min(pu, pv);
+    int j = std::max(pu, pv);
+    if (j - i < 2) return;
+    const int xi = nodeAt(r, i), xi1 = nodeAt(r, i + 1), xj = nodeAt(r, j), xj1 = nodeAt(r, j + 1);
+    double delta = dist(xi, xj) + dist(xi1, xj1) - dist(xi, xi1) - dist(xj, xj1);
+    if (delta < best.delta) best = Move{MoveType::TwoOpt, r, i, 1, r, j, 1, false, delta};
+}
+
+// 2-opt* między trasami: cięcie za u i za v, końcówki wymieniane (u-nv, v-nu)
+// albo początki łączone odwrotnie (u-v, nu-nv).
+void LocalSearch::evaluateTwoOptStar(int ru, int pu, int rv, int pv, Move& best) const {
+    const int u = nodeAt(ru, pu), nu = nodeAt(ru, pu + 1);
+    const int v = nodeAt(rv, pv), nv = nodeAt(rv, pv + 1);
+    const int headU = prefixLoad(ru, pu), headV = prefixLoad(rv, pv);
+    const int tailU = routeLoad[ru] - headU, tailV = routeLoad[rv] - headV;
+    const double removed = dist(u, nu) + dist(v, nv);
+    if (headU + tailV <= problem.capacity && headV + tailU <= problem.capacity) {
+        double delta = dist(u, nv) + dist(v, nu) - removed;
+        if (delta < best.delta) best = Move{MoveType::TwoOptStarTails, ru, pu, 1, rv, pv, 1, false, delta};
+    }
+    if (headU + headV <= problem.capacity && tailU + tailV <= problem.capacity) {
+        double delta = dist(u, v) + dist(nu, nv) - removed;
+        if (delta < best.delta) best = Move{MoveType::TwoOptStarHeads, ru, pu, 1, rv, pv, 1, false, delta};
+    }
+}
+
+void LocalSearch::evaluatePair(int ru, int pu, int rv, int pv, Move& best) const {
+    evaluateRelocate(ru, pu, rv, pv, best);
+    if (ru == rv) {
+        evaluateTwoOpt(ru, pu, pv, best);
+    } else {
+        evaluateTwoOptStar(ru, pu, rv, pv, best);
+    }
+    if (pv >= 0) evaluateSwap(ru, pu, rv, pv, best);
+}
+
+bool LocalSearch::scanCustomer(int u, LsStrategy strategy, Move& best) {
+    const int* candidates = problem.candidates.of(u);
+    for (int c = 0; c < problem.candidates.k(); ++c) {
+        const int v = candidates[c];
+        const int rv = routeOf[v];
+        evaluatePair(routeOf[u], posOf[u], rv, posOf[v], best);
+        // Dla pierwszego klienta trasy także ruchy z depo jako v (np. wstawienie u na początek trasy).
+        if (posOf[v] == 0) evaluatePair(routeOf[u], posOf[u], rv, -1, best);
+        if (strategy == LsStrategy::FirstImprovement && best.delta < -kLsEpsilon) {
+            apply(best);
+            best = Move{};
+            return true;
+        }
+    }
+    return false;
+}
+
+void LocalSearch::apply(const Move& move) {
+    std::vector<int>& routeU = routes[move.ru];
+    std::vector<int>& routeV = routes[move.rv];
+    switch (move.type) {
+        case MoveType::Relocate: {
+            buffer.assign(routeU.begin() + move.pu, routeU.begin() + move.pu + move.lenU);
+            if (move.reversed) std::reverse(buffer.begin(), buffer.end());
+            routeU.erase(routeU.begin() + move.pu, routeU.begin() + move.pu + move.lenU);
+            int insertAt = move.pv + 1;
+            if (move.ru == move.rv && move.pv > move.pu) insertAt -= move.lenU;
+            routeV.insert(routeV.begin() + insertAt, buffer.begin(), buffer.end());
+            break;
+        }
+        case MoveType::Swap: {
+            if (move.ru != move.rv) {
+                buffer.assign(routeU.begin() + move.pu, routeU.begin() + move.pu + move.lenU);
+                std::vector<int> segmentV(routeV.begin() + move.pv, routeV.begin() + move.pv + move.lenV);
+                routeU.erase(routeU.begin() + move.pu, routeU.begin() + move.pu + move.lenU);
+                routeU.insert(routeU.begin() + move.pu, segmentV.begin(), segmentV.end());
+                routeV.erase(routeV.begin() + move.pv, routeV.begin() + move.pv + move.lenV);
+                routeV.insert(routeV.begin() + move.pv, buffer.begin(), buffer.end());
+            } else {
+                // Ta sama trasa: [0, i) + B + (i + lenA, j) + A + (j + lenB, ...).
+                bool uFirst = move.pu < move.pv;
+                int i = uFirst ? move.pu : move.pv, lenA = uFirst ? move.lenU : move.lenV;
+                int j = uFirst ? move.pv : move.pu, lenB = uFirst ? move.lenV : move.lenU;
+                buffer.assign(routeU.begin(), routeU.begin() + i);
+                buffer.insert(buffer.end(), routeU.begin() + j, routeU.begin() + j + lenB);
+                buffer.insert(buffer.end(), routeU.begin() + i + lenA, routeU.begin() + j);
+                buffer.insert(buffer.end(), routeU.begin() + i, routeU.begin() + i + lenA);
+                buffer.insert(buffer.end(), routeU.begin() + j + lenB, routeU.end());
+                routeU.swap(buffer);
+            }
+            break;
+        }
+        case MoveType::TwoOpt:
+            std::reverse(routeU.begin() + move.pu + 1, routeU.begin() + move.pv + 1);
+            break;
+        case MoveType::TwoOptStarTails: {
+            // u-trasa: początek do u + końcówka v; v-trasa: początek do v + końcówka u.
+            buffer.assign(routeU.begin() + move.pu + 1, routeU.end());
+            routeU.resize(move.pu + 1);
+            routeU.insert(routeU.end(), routeV.begin() + move.pv + 1, routeV.end());
+            routeV.resize(move.pv + 1);
+            routeV.insert(routeV.end(), buffer.begin(), buffer.end());
+            break;
+        }
+        case MoveType::TwoOptStarHeads: {
+            // u-trasa: początek do u + odwrócony początek do v; v-trasa: odwrócona końcówka u + końcówka v.
+            buffer.assign(routeU.begin() + move.pu + 1, routeU.end());
+            std::reverse(buffer.begin(), buffer.end());
+            buffer.insert(buffer.end(), routeV.begin() + move.pv + 1, routeV.end());
+            routeU.resize(move.pu + 1);
+            routeU.insert(routeU.end(), routeV.rend() - (move.pv + 1), routeV.rend());
+            routeV.swap(buffer);
+            break;
+        }
+        case MoveType::None:
+            return;
+    }
+    refreshRoute(move.ru);
+    if (move.rv != move.ru) refreshRoute(move.rv);
+}
+
+int LocalSearch::improve(Solution& solution, LsStrategy strategy) {
+    if (problem.candidates.k() == 0 || solution.perm.empty()) return 0;
+    load(solution);
+    shuffleInPlace(order.data(), order.size());
+    int applied = 0;
+    bool improved = true;
+    Move best;
+    while (improved) {
+        improved = false;
+        if (strategy == LsStrategy::FirstImprovement) {
+            for (int u : order) {
+                if (scanCustomer(u, strategy, best)) {
+                    improved = true;
+                    ++applied;
+                }
+            }
+        } else {
+            best = Move{};
+            for (int u : order) scanCustomer(u, strategy, best);
+            if (best.delta < -kLsEpsilon) {
+                apply(best);
+                improved = true;
+                ++applied;
+            }
+        }
+    }
+    store(solution);
+    return applied;
+}
@@ -1,30 +1,220 @@
 #include "Logger.h"
 
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
-CSVLogger::CSVLogger(const std::string& path, const std::string& header) : out(path) {
-    if (!out.is_open()) {
+// Format binarny (.vlog, little-endian):
+//   8 bajtów  "VRPLOG1\n"
+//   uint32    liczba kolumn C
+//   uint32    długość nagłówka L, potem L bajtów nagłówka CSV (nazwy kolumn)
+//   bloki:    uint32 liczba wierszy R, potem C kolumn po R wartości float64
+namespace {
+
+constexpr char kBinaryMagic[8] = {'V', 'R', 'P', 'L', 'O', 'G', '1', '\n'};
+
+// Wspólny wątek zapisu: opróżnia bufory wszystkich otwartych logów, gdy producent przekroczy próg
+// kFlushThreshold wierszy, zabraknie mu miejsca albo zamyka log. Bez żądań śpi na zmiennej warunkowej.
+class LogWriter {
+  public:
+    LogWriter() : worker([this] { run(); }) {}
+
+    ~LogWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCv.notify_one();
+        worker.join();
+    }
+
+    void add(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sinks.push_back(std::move(sink));
+    }
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wakeRequested = true;
+        }
+        wakeCv.notify_one();
+    }
+
+    // Oznacza log jako zamknięty i czeka, aż wątek zapisu dopisze resztę i zamknie plik.
+    void close(LogSink& sink) {
+        sink.closing.store(true, std::memory_order_release);
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeRequested = true;
+        wakeCv.notify_one();
+        doneCv.wait(lock, [&] { return sink.done.load(std::memory_order_relaxed); });
+    }
+
+  private:
+    void run() {
+        std::vector<std::shared_ptr<LogSink>> active;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeCv.wait(lock, [&] { return stopping || wakeRequested; });
+            wakeRequested = false;
+            bool stop = stopping;
+            active = sinks;
+            lock.unlock();
+
+            bool finished = false;
+            for (auto& sink : active) {
+                bool closing = sink->closing.load(std::memory_order_acquire);
+                drain(*sink);
+                if (closing) {
+                    sink->out.close();
+                    sink->done.store(true, std::memory_order_relaxed);
+                    finished = true;
+                }
+            }
+            active.clear();
+
+            lock.lock();
+            if (finished) {
+                sinks.erase(std::remove_if(sinks.begin(), sinks.end(),
+                                           [](const auto& s) { return s->done.load(std::memory_order_relaxed); }),
+                            sinks.end());
+                doneCv.notify_all();
+            }
+            if (stop && sinks.empty()) return;
+        }
+    }
+
+    // Zapisuje rekordy [tail, head) w ciągłych kawałkach bufora i przesuwa tail.
+    static void drain(LogSink& sink) {
+        const std::size_t mask = LogSink::kCapacity - 1;
+        std::size_t tail = sink.tail.load(std::memory_order_relaxed);
+        const std::size_t head = sink.head.load(std::memory_order_acquire);
+        while (tail != head) {
+            std::size_t count = std::min(head - tail, LogSink::kCapacity - (tail & mask));
+            const LogRecord* records = sink.ring.data() + (tail & mask);
+            if (sink.format == LogFormat::Binary) writeBinary(sink, records, count);
+            else writeCsv(sink, records, count);
+            tail += count;
+            sink.tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    static void writeCsv(LogSink& sink, const LogRecord* records, std::size_t count) {
+        std::string text;
+        text.reserve(count * 16 * static_cast<std::size_t>(sink.columns));
+        // Ten sam zapis co std::to_string: krok jako liczba całkowita, reszta "%f" (6 miejsc).
+        char line[kMaxLogColumns * 64];
+        for (std::size_t r = 0; r < count; ++r) {
+            char* pos = std::to_chars(line, line + sizeof(line), static_cast<long long>(records[r].values[0])).ptr;
+            for (int c = 1; c < sink.columns; ++c) {
+                *pos++ = ',';
+                pos = std::to_chars(pos, line + sizeof(line), records[r].values[c], std::chars_format::fixed, 6).ptr;
+            }
+            *pos++ = '\n';
+            text.append(line, static_cast<std::size_t>(pos - line));
+        }
+        sink.out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    static void writeBinary(LogSink& sink, const LogRecord* records, std::size_t count) {
+        sink.columnBlock.resize(count * static_cast<std::size_t>(sink.columns));
+        for (int c = 0; c < sink.columns; ++c) {
+            double* column = sink.columnBlock.data() + static_cast<std::size_t>(c) * count;
+            for (std::size_t r = 0; r < count; ++r) column[r] = records[r].values[c];
+        }
+        std::uint32_t rows = static_cast<std::uint32_t>(count);
+        sink.out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+        sink.out.write(reinterpret_cast<const char*>(sink.columnBlock.data()),
+                       static_cast<std::streamsize>(sink.columnBlock.size() * sizeof(double)));
+    }
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    std::vector<std::shared_ptr<LogSink>> sinks;
+    bool wakeRequested = false;
+    bool stopping = false;
+    std::thread worker;
+};
+
+LogWriter& logWriter() {
+    static LogWriter writer;
+    return writer;
+}
+
+}  // namespace
+
+LogFormat parseLogFormat(const std::string& name) {
+    if (name == "csv") return LogFormat::Csv;
+    if (name == "binary") return LogFormat::Binary;
+    throw std::invalid_argument("Nieznany format logu: " + name + " (dozwolone: csv, binary)");
+}
+
+const char* logExtension(LogFormat format) {
+    return format == LogFormat::Binary ? ".vlog" : ".csv";
+}
+
+LogPolicy parseLogPolicy(const std::string& name) {
+    if (name == "all") return LogPolicy::All;
+    if (name == "every") return LogPolicy::Every;
+    if (name == "improvement") return LogPolicy::Improvement;
+    throw std::invalid_argument("Nieznana polityka logu: " + name + " (dozwolone: all, every, improvement)");
+}
+
+CSVLogger::CSVLogger(const std::string& path, const std::string& header, LogFormat format)
+    : filePath(path), fileFormat(format) {
+    int columns = header.empty() ? 0 : static_cast<int>(std::count(header.begin(), header.end(), ',')) + 1;
+    if (columns == 0 || columns > kMaxLogColumns) {
+        throw std::invalid_argument("Nagłówek logu musi mieć od 1 do " + std::to_string(kMaxLogColumns) +
+                                    " kolumn: " + header);
+    }
+    auto created = std::make_shared<LogSink>();
+    created->format = format;
+    created->columns = columns;
+    created->out.open(path, format == LogFormat::Binary ? std::ios::binary : std::ios::out);
+    if (!created->out.is_open()) {
         std::cerr << "Nie można otworzyć pliku logu: " << path << "\n";
         return;
     }
-    if (!header.empty()) {
-        out << header << "\n";
+    if (format == LogFormat::Binary) {
+        std::uint32_t columnCount = static_cast<std::uint32_t>(columns);
+        std::uint32_t headerLength = static_cast<std::uint32_t>(header.size());
+        created->out.write(kBinaryMagic, sizeof(kBinaryMagic));
+        created->out.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+        created->out.write(reinterpret_cast<const char*>(&headerLength), sizeof(headerLength));
+        created->out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    } else {
+        created->out << header << "\n";
     }
+    sink = std::move(created);
+    logWriter().add(sink);
 }
 
 CSVLogger::~CSVLogger() {
-    if (out.is_open()) {
-        out.close();
-    }
+    if (!sink) return;
+    if (hasPending) push(pending.values, sink->columns);
+    logWriter().close(*sink);
 }
 
-void CSVLogger::logRow(const std::string& row) {
-    if (!out.is_open()) {
-        return;
-    }
-    out << row << "\n";
+void CSVLogger::setPolicy(LogPolicy logPolicy, int everySteps) {
+    policy = logPolicy;
+    every = everySteps > 0 ? everySteps : 1;
+}
+
+void CSVLogger::requestFlush() {
+    flushAt += LogSink::kFlushThreshold;
+    logWriter().wake();
 }
 
-bool CSVLogger::ok() const {
-    return out.is_open();
+void CSVLogger::waitForSpace(std::size_t slot) {
+    while (true) {
+        sinkTail = sink->tail.load(std::memory_order_acquire);
+        if (slot - sinkTail < LogSink::kCapacity) return;
+        logWriter().wake();
+        std::this_thread::yield();
+    }
 }
@@ -0,0 +1,130 @@
+// Budowa list k najbliższych sąsiadów przez siatkę jednorodną: O(n log n) zamiast O(n²). Instancje
+// EXPLICIT nie mają współrzędnych odpowiadających odległościom - tam listy powstają z wierszy macierzy.
+#include "Neighbors.h"
+
+#include "VRP.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+class CandidateListsBuilder {
+  public:
+    explicit CandidateListsBuilder(const Problem& problem) : problem(problem) {
+        for (int id = 1; id <= problem.dimension; ++id) {
+            if (id != problem.depotId) customers.push_back(id);
+        }
+        fromMatrix = problem.edgeWeightType == EdgeWeightType::Explicit;
+        if (!fromMatrix) buildGrid();
+    }
+
+    CandidateLists build(int k) {
+        CandidateLists lists;
+        lists.perNode = std::max(0, std::min(k, static_cast<int>(customers.size()) - 1));
+        lists.ids.assign(static_cast<std::size_t>(problem.dimension + 1) * lists.perNode, 0);
+        if (lists.perNode == 0) return lists;
+        for (int id = 1; id <= problem.dimension; ++id) {
+            int* out = lists.ids.data() + static_cast<std::size_t>(id) * lists.perNode;
+            if (fromMatrix) nearestInRow(id, lists.perNode, out);
+            else nearest(id, lists.perNode, out);
+        }
+        return lists;
+    }
+
+  private:
+    // Klienci rozłożeni do komórek siatki (ok. 2 na komórkę) w układzie CSR.
+    void buildGrid() {
+        double minX = 0.0, maxX = 0.0, minY = 0.0, maxY = 0.0;
+        if (!customers.empty()) {
+            minX = maxX = problem.xs[customers[0]];
+            minY = maxY = problem.ys[customers[0]];
+        }
+        for (int id : customers) {
+            minX = std::min(minX, problem.xs[id]);
+            maxX = std::max(maxX, problem.xs[id]);
+            minY = std::min(minY, problem.ys[id]);
+            maxY = std::max(maxY, problem.ys[id]);
+        }
+        side = std::max(1, static_cast<int>(std::ceil(std::sqrt(customers.size() / 2.0))));
+        originX = minX;
+        originY = minY;
+        cellW = std::max((maxX - minX) / side, 1e-9);
+        cellH = std::max((maxY - minY) / side, 1e-9);
+        cellStart.assign(static_cast<std::size_t>(side) * side + 1, 0);
+        for (int id : customers) ++cellStart[cellOf(id) + 1];
+        for (std::size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+        cellItems.resize(customers.size());
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int id : customers) cellItems[fill[cellOf(id)]++] = id;
+    }
+
+    int clampCell(double offset, double size) const {
+        return std::min(side - 1, std::max(0, static_cast<int>(offset / size)));
+    }
+    int cellOf(int id) const {
+        return clampCell(problem.ys[id] - originY, cellH) * side + clampCell(problem.xs[id] - originX, cellW);
+    }
+
+    // Przegląda pierścienie komórek wokół węzła, aż k-ty kandydat jest bliżej niż nieprzejrzane komórki.
+    void nearest(int id, int k, int* out) {
+        const double x = problem.xs[id];
+        const double y = problem.ys[id];
+        const int cx = clampCell(x - originX, cellW);
+        const int cy = clampCell(y - originY, cellH);
+        found.clear();
+        auto byDistance = [](const std::pair<double, int>& a, const std::pair<double, int>& b) { return a < b; };
+        for (int r = 0; r < side; ++r) {
+            for (int gy = cy - r; gy <= cy + r; ++gy) {
+                if (gy < 0 || gy >= side) continue;
+                // Na brzegach pierścienia cały wiersz, w środku tylko dwie skrajne komórki.
+                int step = (gy == cy - r || gy == cy + r) ? 1 : std::max(1, 2 * r);
+                for (int gx = cx - r; gx <= cx + r; gx += step) {
+                    if (gx < 0 || gx >= side) continue;
+                    int cell = gy * side + gx;
+                    for (int p = cellStart[cell]; p < cellStart[cell + 1]; ++p) {
+                        int other = cellItems[p];
+                        if (other == id) continue;
+                        double dx = problem.xs[other] - x;
+                        double dy = problem.ys[other] - y;
+                        found.emplace_back(dx * dx + dy * dy, other);
+                    }
+                }
+            }
+            if (static_cast<int>(found.size()) >= k) {
+                // Komórki spoza pierścienia r leżą dalej niż r * min(cellW, cellH) od węzła.
+                std::nth_element(found.begin(), found.begin() + (k - 1), found.end(), byDistance);
+                double reach = r * std::min(cellW, cellH);
+                if (found[k - 1].first <= reach * reach) break;
+            }
+        }
+        std::partial_sort(found.begin(), found.begin() + k, found.end(), byDistance);
+        for (int i = 0; i < k; ++i) out[i] = found[i].second;
+    }
+
+    // Pełny przegląd wiersza macierzy odległości (O(n) na węzeł).
+    void nearestInRow(int id, int k, int* out) {
+        found.clear();
+        for (int other : customers) {
+            if (other != id) found.emplace_back(problem.distances(id, other), other);
+        }
+        std::partial_sort(found.begin(), found.begin() + k, found.end());
+        for (int i = 0; i < k; ++i) out[i] = found[i].second;
+    }
+
+    const Problem& problem;
+    std::vector<int> customers;
+    bool fromMatrix = false;    // EXPLICIT: sąsiedztwo z macierzy zamiast siatki
+    int side = 1;               // liczba komórek w wierszu i kolumnie
+    double originX = 0.0;
+    double originY = 0.0;
+    double cellW = 1.0;
+    double cellH = 1.0;
+    std::vector<int> cellStart;   // początek komórki w cellItems (CSR)
+    std::vector<int> cellItems;   // id klientów pogrupowane po komórkach
+    std::vector<std::pair<double, int>> found;  // (kwadrat odległości lub odległość, id) zebrani kandydaci
+};
+
+void buildCandidateLists(Problem& problem, int k) {
+    problem.candidates = CandidateListsBuilder(problem).build(k);
+}
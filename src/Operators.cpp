@@ -0,0 +1,519 @@
+#include "Operators.h"
+
+#include "FitnessCache.h"
+#include "NodeBitset.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+CrossoverType parseCrossoverType(const std::string& name) {
+    if (name == "pmx") return CrossoverType::PartiallyMapped;
+    if (name == "cx" || name == "cycle") return CrossoverType::Cycle;
+    if (name == "erx") return CrossoverType::EdgeRecombination;
+    if (name == "eax") return CrossoverType::EdgeAssembly;
+    return CrossoverType::Ordered;
+}
+
+MutationType parseMutationType(const std::string& name) {
+    if (name == "inversion" || name == "inv") return MutationType::Inversion;
+    return MutationType::Swap;
+}
+
+CrossoverWorkspace::CrossoverWorkspace(int valueRange)
+    : mark(valueRange, 0), posInP1(valueRange, 0), posInP2(valueRange, 0), neighbors(4 * valueRange, 0),
+      degree(valueRange, 0), slot(valueRange, 0) {}
+
+std::uint32_t CrossoverWorkspace::nextStamp() {
+    if (++stamp == 0) {
+        std::fill(mark.begin(), mark.end(), 0);
+        stamp = 1;
+    }
+    return stamp;
+}
+
+// Losuje segment [a, b] tak jak dotychczasowe operatory (dwa losowania, potem uporządkowanie).
+static void drawSegment(int n, int& a, int& b) {
+    a = randInt(0, n - 1);
+    b = randInt(0, n - 1);
+    if (a > b) std::swap(a, b);
+}
+
+// Największa wartość genu obsługiwana przez workspace (dobór szybkiej ścieżki małych instancji).
+static int maxGeneValue(const CrossoverWorkspace& ws) { return static_cast<int>(ws.mark.size()) - 1; }
+
+// Szybka ścieżka OX/PMX/CX dla wartości i pozycji < 64 * Words: zbiory w NodeBitset, pozycje w p2 w
+// tablicy uint8_t na stosie. Te same losowania i wynik co wersje ogólne ze stemplami w workspace.
+template <int Words>
+static void orderedSmall(const int* p1, const int* p2, int n, int* child) {
+    int a, b;
+    drawSegment(n, a, b);
+    NodeBitset<Words> used;
+    for (int i = a; i <= b; ++i) {
+        child[i] = p1[i];
+        used.set(p1[i]);
+    }
+    int pos = b + 1 == n ? 0 : b + 1;
+    for (int i = 0, from = pos; i < n; ++i, from = from + 1 == n ? 0 : from + 1) {
+        int candidate = p2[from];
+        if (used.test(candidate)) continue;
+        child[pos] = candidate;
+        pos = pos + 1 == n ? 0 : pos + 1;
+    }
+}
+
+template <int Words>
+static void pmxSmall(const int* p1, const int* p2, int n, int* child) {
+    int a, b;
+    drawSegment(n, a, b);
+    std::array<std::uint8_t, NodeBitset<Words>::kCapacity> posInP2;
+    for (int i = 0; i < n; ++i) posInP2[p2[i]] = static_cast<std::uint8_t>(i);
+    NodeBitset<Words> used, filled;
+    for (int i = a; i <= b; ++i) {
+        child[i] = p1[i];
+        used.set(p1[i]);
+        filled.set(i);
+    }
+    for (int i = a; i <= b; ++i) {
+        int val = p2[i];
+        if (used.test(val)) continue;
+        int pos = i;
+        while (filled.test(pos)) pos = posInP2[p1[pos]];
+        child[pos] = val;
+        filled.set(pos);
+        used.set(val);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (!filled.test(i)) child[i] = p2[i];
+    }
+}
+
+template <int Words>
+static void cycleSmall(const int* p1, const int* p2, int n, int* child) {
+    std::array<std::uint8_t, NodeBitset<Words>::kCapacity> posInP2;
+    for (int i = 0; i < n; ++i) posInP2[p2[i]] = static_cast<std::uint8_t>(i);
+    NodeBitset<Words> visited;
+    bool takeFromP1 = true;
+    for (int start = visited.nextUnset(0); start < n; start = visited.nextUnset(start + 1)) {
+        int idx = start;
+        do {
+            visited.set(idx);
+            child[idx] = takeFromP1 ? p1[idx] : p2[idx];
+            idx = posInP2[p1[idx]];
+        } while (idx != start);
+        takeFromP1 = !takeFromP1;
+    }
+}
+
+void orderedCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                      CrossoverWorkspace& ws) {
+    child.resize(n);
+    if (n == 0) return;
+    // Przy 2-4 słowach seria ustawień bitów segmentu to zależny łańcuch zapisów do tych samych słów -
+    // wolniej niż niezależne stemple, więc OX korzysta z szybkiej ścieżki tylko dla jednego słowa.
+    if (smallPathWords(maxGeneValue(ws)) == 1) return orderedSmall<1>(p1, p2, n, child.data());
+    int a, b;
+    drawSegment(n, a, b);
+    const std::uint32_t s = ws.nextStamp();
+    for (int i = a; i <= b; ++i) {
+        child[i] = p1[i];
+        ws.mark[p1[i]] = s;
+    }
+    // Wolne pozycje od b+1 cyklicznie; kandydaci z p2 też od b+1.
+    int pos = b + 1 == n ? 0 : b + 1;
+    for (int i = 0, from = pos; i < n; ++i, from = from + 1 == n ? 0 : from + 1) {
+        int candidate = p2[from];
+        if (ws.mark[candidate] == s) continue;
+        child[pos] = candidate;
+        pos = pos + 1 == n ? 0 : pos + 1;
+    }
+}
+
+void pmxCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                  CrossoverWorkspace& ws) {
+    child.resize(n);
+    if (n == 0) return;
+    auto small = [&](auto words) { pmxSmall<decltype(words)::value>(p1, p2, n, child.data()); };
+    if (dispatchSmallPath(maxGeneValue(ws), small)) return;
+    std::fill(child.begin(), child.end(), -1);
+    int a, b;
+    drawSegment(n, a, b);
+    for (int i = 0; i < n; ++i) ws.posInP2[p2[i]] = i;
+    const std::uint32_t s = ws.nextStamp();
+    for (int i = a; i <= b; ++i) {
+        child[i] = p1[i];
+        ws.mark[p1[i]] = s;
+    }
+    // Geny p2 z segmentu, których nie ma w dziecku, idą na pozycję wskazaną łańcuchem odwzorowań.
+    for (int i = a; i <= b; ++i) {
+        int val = p2[i];
+        if (ws.mark[val] == s) continue;
+        int pos = i;
+        while (child[pos] != -1) pos = ws.posInP2[p1[pos]];
+        child[pos] = val;
+        ws.mark[val] = s;
+    }
+    // Pozostałe pozycje dostają gen p2 z tej samej pozycji (żaden nie jest jeszcze użyty).
+    for (int i = 0; i < n; ++i) {
+        if (child[i] == -1) child[i] = p2[i];
+    }
+}
+
+void cycleCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                    CrossoverWorkspace& ws) {
+    child.resize(n);
+    auto small = [&](auto words) { cycleSmall<decltype(words)::value>(p1, p2, n, child.data()); };
+    if (dispatchSmallPath(maxGeneValue(ws), small)) return;
+    for (int i = 0; i < n; ++i) ws.posInP2[p2[i]] = i;
+    // Odwiedzona pozycja idx jest oznaczona stemplem na wartości p1[idx].
+    const std::uint32_t s = ws.nextStamp();
+    bool takeFromP1 = true;
+    for (int start = 0; start < n; ++start) {
+        if (ws.mark[p1[start]] == s) continue;
+        int idx = start;
+        do {
+            ws.mark[p1[idx]] = s;
+            child[idx] = takeFromP1 ? p1[idx] : p2[idx];
+            idx = ws.posInP2[p1[idx]];
+        } while (idx != start);
+        takeFromP1 = !takeFromP1;
+    }
+}
+
+void edgeRecombinationCrossover(const int* p1, const int* p2, int n, std::vector<int>& child,
+                                CrossoverWorkspace& ws) {
+    child.resize(n);
+    if (n < 3) {
+        std::copy(p1, p1 + n, child.begin());
+        return;
+    }
+    // Tablica krawędzi: sąsiedzi w obu rodzicach (trasy traktowane cyklicznie), bez powtórzeń.
+    ws.pool.clear();
+    for (int i = 0; i < n; ++i) {
+        ws.degree[p1[i]] = 0;
+        ws.slot[p1[i]] = static_cast<int>(ws.pool.size());
+        ws.pool.push_back(p1[i]);
+    }
+    auto addEdge = [&](int from, int to) {
+        int* list = ws.neighbors.data() + 4 * from;
+        for (int k = 0; k < ws.degree[from]; ++k) if (list[k] == to) return;
+        list[ws.degree[from]++] = to;
+    };
+    for (const int* p : {p1, p2}) {
+        for (int i = 0; i < n; ++i) {
+            addEdge(p[i], p[i == 0 ? n - 1 : i - 1]);
+            addEdge(p[i], p[i + 1 == n ? 0 : i + 1]);
+        }
+    }
+    int current = p1[0];
+    for (int step = 0; step < n; ++step) {
+        child[step] = current;
+        // Usuń bieżący z puli nieodwiedzonych i z list jego sąsiadów.
+        int last = ws.pool.back();
+        ws.pool[ws.slot[current]] = last;
+        ws.slot[last] = ws.slot[current];
+        ws.pool.pop_back();
+        const int* list = ws.neighbors.data() + 4 * current;
+        for (int k = 0; k < ws.degree[current]; ++k) {
+            int w = list[k];
+            int* wList = ws.neighbors.data() + 4 * w;
+            for (int t = 0; t < ws.degree[w]; ++t) {
+                if (wList[t] == current) {
+                    wList[t] = wList[--ws.degree[w]];
+                    break;
+                }
+            }
+        }
+        if (ws.pool.empty()) break;
+        // Sąsiad z najmniejszą liczbą pozostałych sąsiadów; remisy losowo (losowanie rezerwuarowe).
+        int next = -1;
+        int bestDegree = std::numeric_limits<int>::max();
+        int ties = 0;
+        for (int k = 0; k < ws.degree[current]; ++k) {
+            int w = list[k];
+            if (ws.degree[w] < bestDegree) {
+                bestDegree = ws.degree[w];
+                next = w;
+                ties = 1;
+            } else if (ws.degree[w] == bestDegree && randInt(0, ties++) == 0) {
+                next = w;
+            }
+        }
+        if (next < 0) next = ws.pool[randInt(0, static_cast<int>(ws.pool.size()) - 1)];
+        current = next;
+    }
+}
+
+// Usuwa krawędź do `to` z pary slotów (slot -1 oznacza brak krawędzi).
+static void dropEdge(int* pair, int to) {
+    if (pair[0] == to) pair[0] = -1;
+    else if (pair[1] == to) pair[1] = -1;
+}
+
+// Zamienia sąsiada `from` na `to` w parze slotów.
+static void replaceEdge(int* pair, int from, int to) {
+    if (pair[0] == from) pair[0] = to;
+    else pair[1] = to;
+}
+
+void edgeAssemblyCrossover(const Problem& problem, const int* p1, const int* p2, int n,
+                           std::vector<int>& child, CrossoverWorkspace& ws) {
+    child.resize(n);
+    std::copy(p1, p1 + n, child.begin());
+    if (n < 5) return;
+    auto next = [n](int i) { return i + 1 == n ? 0 : i + 1; };
+    auto prev = [n](int i) { return i == 0 ? n - 1 : i - 1; };
+    auto dist = [&](int i, int j) { return static_cast<double>(problem.distances(p1[i], p1[j])); };
+
+    // Węzły lokalne 0..n-1 to pozycje w p1 (krawędzie A: i, i+1); trasa p2 w węzłach lokalnych (B).
+    for (int i = 0; i < n; ++i) ws.posInP1[p1[i]] = i;
+    ws.bNode.resize(n);
+    ws.bPos.resize(n);
+    for (int k = 0; k < n; ++k) {
+        ws.bNode[k] = ws.posInP1[p2[k]];
+        ws.bPos[ws.bNode[k]] = k;
+    }
+    ws.remA.resize(2 * n);
+    ws.remB.resize(2 * n);
+    int differing = 0;
+    for (int i = 0; i < n; ++i) {
+        int k = ws.bPos[i];
+        int bPrev = ws.bNode[k == 0 ? n - 1 : k - 1];
+        int bNext = ws.bNode[k + 1 == n ? 0 : k + 1];
+        // Krawędzie wspólne obu rodziców nie biorą udziału w cyklach AB.
+        ws.remA[2 * i] = prev(i) == bPrev || prev(i) == bNext ? -1 : prev(i);
+        ws.remA[2 * i + 1] = next(i) == bPrev || next(i) == bNext ? -1 : next(i);
+        ws.remB[2 * i] = bPrev == prev(i) || bPrev == next(i) ? -1 : bPrev;
+        ws.remB[2 * i + 1] = bNext == prev(i) || bNext == next(i) ? -1 : bNext;
+        if (ws.remA[2 * i + 1] >= 0) ++differing;
+    }
+    if (differing == 0) return;
+
+    // Losowy start z krawędzią A spoza p2, potem marsz na przemian A/B, aż ścieżka zamknie cykl AB.
+    int start = randInt(0, n - 1);
+    while (ws.remA[2 * start] < 0 && ws.remA[2 * start + 1] < 0) start = next(start);
+    ws.leftA.assign(n, -1);
+    ws.leftB.assign(n, -1);
+    ws.path.clear();
+    int current = start;
+    bool takeA = true;
+    int cycleBegin = -1;
+    while (cycleBegin < 0) {
+        std::vector<int>& rem = takeA ? ws.remA : ws.remB;
+        int* pair = rem.data() + 2 * current;
+        int choice;
+        if (pair[0] >= 0 && pair[1] >= 0) choice = randInt(0, 1);
+        else if (pair[0] >= 0) choice = 0;
+        else if (pair[1] >= 0) choice = 1;
+        else return;  // nie powinno wystąpić (stopnie A i B w każdym węźle są równe)
+        int to = pair[choice];
+        pair[choice] = -1;
+        dropEdge(rem.data() + 2 * to, current);
+        (takeA ? ws.leftA : ws.leftB)[current] = static_cast<int>(ws.path.size());
+        ws.path.push_back(current);
+        current = to;
+        takeA = !takeA;
+        // Zamknięcie: węzeł opuszczono wcześniej krawędzią typu, który byłby teraz następny.
+        int left = takeA ? ws.leftA[current] : ws.leftB[current];
+        if (left >= 0) cycleBegin = left;
+    }
+    const int closing = current;
+
+    // Rozwiązanie pośrednie: p1 bez krawędzi A cyklu, z krawędziami B cyklu.
+    ws.adj.resize(2 * n);
+    for (int i = 0; i < n; ++i) {
+        ws.adj[2 * i] = prev(i);
+        ws.adj[2 * i + 1] = next(i);
+    }
+    const int pathLength = static_cast<int>(ws.path.size());
+    for (int idx = cycleBegin; idx < pathLength; ++idx) {
+        int u = ws.path[idx];
+        int v = idx + 1 < pathLength ? ws.path[idx + 1] : closing;
+        if ((idx & 1) == 0) {
+            dropEdge(ws.adj.data() + 2 * u, v);
+            dropEdge(ws.adj.data() + 2 * v, u);
+        }
+    }
+    for (int idx = cycleBegin; idx < pathLength; ++idx) {
+        int u = ws.path[idx];
+        int v = idx + 1 < pathLength ? ws.path[idx + 1] : closing;
+        if ((idx & 1) == 1) {
+            replaceEdge(ws.adj.data() + 2 * u, -1, v);
+            replaceEdge(ws.adj.data() + 2 * v, -1, u);
+        }
+    }
+
+    // Podcykle jako listy węzłów.
+    ws.subtour.assign(n, -1);
+    ws.nextMember.assign(n, -1);
+    ws.head.clear();
+    ws.tail.clear();
+    ws.size.clear();
+    for (int i = 0; i < n; ++i) {
+        if (ws.subtour[i] >= 0) continue;
+        int id = static_cast<int>(ws.head.size());
+        ws.head.push_back(i);
+        ws.size.push_back(0);
+        int before = -1, node = i, last = i;
+        do {
+            ws.subtour[node] = id;
+            if (node != i) ws.nextMember[last] = node;
+            last = node;
+            ++ws.size[id];
+            int step = ws.adj[2 * node] != before ? ws.adj[2 * node] : ws.adj[2 * node + 1];
+            before = node;
+            node = step;
+        } while (node != i);
+        ws.tail.push_back(last);
+    }
+
+    // Scalanie: podcykle w kolejności rosnących rozmiarów; każdy łączony z innym najtańszą wymianą
+    // dwóch krawędzi (u-u', v-v'), gdzie v jest kandydatem u. Przenumerowywany jest mniejszy z pary.
+    int alive = static_cast<int>(ws.head.size());
+    const int k = problem.candidates.k();
+    ws.order.resize(alive);
+    for (int id = 0; id < alive; ++id) ws.order[id] = id;
+    std::sort(ws.order.begin(), ws.order.end(), [&](int x, int y) { return ws.size[x] < ws.size[y]; });
+    for (int small : ws.order) {
+        if (alive == 1) break;
+        if (ws.size[small] == 0) continue;
+        double bestDelta = std::numeric_limits<double>::infinity();
+        int bu = -1, bu2 = -1, bv = -1, bv2 = -1;
+        auto consider = [&](int u, int v) {
+            for (int su = 0; su < 2; ++su) {
+                int u2 = ws.adj[2 * u + su];
+                for (int sv = 0; sv < 2; ++sv) {
+                    int v2 = ws.adj[2 * v + sv];
+                    double removed = dist(u, u2) + dist(v, v2);
+                    double straight = dist(u, v) + dist(u2, v2) - removed;
+                    if (straight < bestDelta) {
+                        bestDelta = straight;
+                        bu = u, bu2 = u2, bv = v, bv2 = v2;
+                    }
+                    double crossed = dist(u, v2) + dist(u2, v) - removed;
+                    if (crossed < bestDelta) {
+                        bestDelta = crossed;
+                        bu = u, bu2 = u2, bv = v2, bv2 = v;
+                    }
+                }
+            }
+        };
+        for (int u = ws.head[small]; u >= 0; u = ws.nextMember[u]) {
+            const int* candidates = k > 0 ? problem.candidates.of(p1[u]) : nullptr;
+            for (int c = 0; c < k; ++c) {
+                int v = ws.posInP1[candidates[c]];
+                if (ws.subtour[v] != small) consider(u, v);
+            }
+        }
+        if (bu < 0) {
+            // Żaden kandydat nie leży poza podcyklem: przegląd wszystkich węzłów dla pierwszego węzła.
+            for (int v = 0; v < n; ++v) {
+                if (ws.subtour[v] != small) consider(ws.head[small], v);
+            }
+        }
+        // Krawędzie (bu, bu2), (bv, bv2) zastępujemy przez (bu, bv), (bu2, bv2).
+        replaceEdge(ws.adj.data() + 2 * bu, bu2, bv);
+        replaceEdge(ws.adj.data() + 2 * bu2, bu, bv2);
+        replaceEdge(ws.adj.data() + 2 * bv, bv2, bu);
+        replaceEdge(ws.adj.data() + 2 * bv2, bv, bu2);
+        int keep = ws.subtour[bv], drop = small;
+        if (ws.size[keep] < ws.size[drop]) std::swap(keep, drop);
+        for (int u = ws.head[drop]; u >= 0; u = ws.nextMember[u]) ws.subtour[u] = keep;
+        ws.nextMember[ws.tail[keep]] = ws.head[drop];
+        ws.tail[keep] = ws.tail[drop];
+        ws.size[keep] += ws.size[drop];
+        ws.size[drop] = 0;
+        --alive;
+    }
+
+    // Odczyt jednego cyklu od węzła 0.
+    int before = -1, node = 0;
+    for (int i = 0; i < n; ++i) {
+        child[i] = p1[node];
+        int step = ws.adj[2 * node] != before ? ws.adj[2 * node] : ws.adj[2 * node + 1];
+        before = node;
+        node = step;
+    }
+}
+
+void crossover(CrossoverType type, const Problem& problem, const int* p1, const int* p2, int n,
+               std::vector<int>& child, CrossoverWorkspace& ws) {
+    switch (type) {
+        case CrossoverType::PartiallyMapped: pmxCrossover(p1, p2, n, child, ws); break;
+        case CrossoverType::Cycle: cycleCrossover(p1, p2, n, child, ws); break;
+        case CrossoverType::EdgeRecombination: edgeRecombinationCrossover(p1, p2, n, child, ws); break;
+        case CrossoverType::EdgeAssembly: edgeAssemblyCrossover(problem, p1, p2, n, child, ws); break;
+        case CrossoverType::Ordered: orderedCrossover(p1, p2, n, child, ws); break;
+    }
+}
+
+bool mutateSwap(std::vector<int>& perm, std::uint64_t& hash, double mutationRate) {
+    if (perm.size() < 2) return false;
+    if (randUnit() < mutationRate) {
+        int i = randInt(0, static_cast<int>(perm.size()) - 1);
+        int j = randInt(0, static_cast<int>(perm.size()) - 1);
+        while (j == i) j = randInt(0, static_cast<int>(perm.size()) - 1);
+        hash = hashAfterSwap(hash, perm.data(), static_cast<int>(perm.size()), i, j);
+        std::swap(perm[i], perm[j]);
+        return true;
+    }
+    return false;
+}
+
+bool mutateInversion(std::vector<int>& perm, std::uint64_t& hash, double mutationRate) {
+    if (perm.size() < 2) return false;
+    if (randUnit() < mutationRate) {
+        int a = randInt(0, static_cast<int>(perm.size()) - 1);
+        int b = randInt(0, static_cast<int>(perm.size()) - 1);
+        if (a > b) std::swap(a, b);
+        hash = hashAfterReverse(hash, perm.data(), static_cast<int>(perm.size()), a, b);
+        std::reverse(perm.begin() + a, perm.begin() + b + 1);
+        return a < b;
+    }
+    return false;
+}
+
+bool twoOptOnce(std::vector<int>& perm, std::uint64_t& hash, const Problem& problem) {
+    int n = static_cast<int>(perm.size());
+    if (n < 4) return false;
+    int i = randInt(0, n - 2);
+    int k = randInt(i + 1, n - 1);
+    // Oblicz koszt fragmentu przed/po 2-opt (w permutacji; dekoder doda depo później).
+    auto edgeCost = [&](int aIdx, int bIdx) {
+        int aNode = perm[aIdx];
+        int bNode = perm[bIdx];
+        return problem.distances(aNode, bNode);
+    };
+    double before = 0.0;
+    double after = 0.0;
+    if (i > 0) {
+        before += edgeCost(i - 1, i);
+        after += edgeCost(i - 1, k);
+    }
+    if (k + 1 < n) {
+        before += edgeCost(k, k + 1);
+        after += edgeCost(i, k + 1);
+    }
+    // Krawędzie wewnątrz segmentu się nie zmieniają (macierz symetryczna).
+    if (after + 1e-9 < before) {
+        hash = hashAfterReverse(hash, perm.data(), n, i, k);
+        std::reverse(perm.begin() + i, perm.begin() + k + 1);
+        return true;
+    }
+    return false;
+}
+
+int tournamentSelect(const Population& pop, int tourSize) {
+    int bestIdx = -1;
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < tourSize; ++i) {
+        int idx = randInt(0, pop.size() - 1);
+        if (pop.cost(idx) < bestCost) {
+            bestCost = pop.cost(idx);
+            bestIdx = idx;
+        }
+    }
+    return bestIdx;
+}
@@ -0,0 +1,208 @@
+#include "Perf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+thread_local RunMetrics* tlsMetrics = nullptr;
+thread_local long long tlsAllocations = 0;
+}  // namespace
+
+// Zliczanie alokacji zastępuje globalne operator new/delete. Pod AddressSanitizerem zastąpienie jest
+// pomijane (licznik alokacji wynosi wtedy 0), żeby sanitizer sam sprawdzał pary new/delete.
+#if defined(__SANITIZE_ADDRESS__)
+#define VRP_COUNT_ALLOCATIONS 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define VRP_COUNT_ALLOCATIONS 0
+#endif
+#endif
+#ifndef VRP_COUNT_ALLOCATIONS
+#define VRP_COUNT_ALLOCATIONS VRP_PERF
+#endif
+
+#if VRP_COUNT_ALLOCATIONS
+// Zastąpione globalne operator new/delete: zliczają alokacje wątku (jeden licznik thread_local).
+// Zastąpiony jest komplet wariantów (zwykłe, nothrow, z wyrównaniem), więc każda para przechodzi
+// przez malloc/aligned_alloc i free.
+namespace {
+void* countedAlloc(std::size_t size) noexcept {
+    ++tlsAllocations;
+    return std::malloc(size ? size : 1);
+}
+void* countedAlloc(std::size_t size, std::align_val_t alignment) noexcept {
+    ++tlsAllocations;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wymaga rozmiaru będącego wielokrotnością wyrównania.
+    return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, alignment);
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+#endif
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Selection: return "selection";
+        case Phase::Crossover: return "crossover";
+        case Phase::Mutation: return "mutation";
+        case Phase::LocalSearch: return "local_search";
+        case Phase::Decode: return "decode";
+        case Phase::Logging: return "logging";
+    }
+    return "unknown";
+}
+
+void RunMetrics::merge(const RunMetrics& other) {
+    allocations += other.allocations;
+    for (int p = 0; p < kPhaseCount; ++p) phaseNs[p] += other.phaseNs[p];
+}
+
+void RunMetrics::foldSamples() {
+    double sampled = 0.0;
+    for (int p = 0; p < kPhaseCount; ++p) sampled += sampledNs[p];
+    if (sampled > 0.0) {
+        for (int p = 0; p < kPhaseCount; ++p) phaseNs[p] += sampledScopeNs * sampledNs[p] / sampled;
+    }
+    std::fill(sampledNs, sampledNs + kPhaseCount, 0.0);
+    sampledScopeNs = 0.0;
+}
+
+bool RunMetrics::writeJson(const std::string& path, const std::string& algorithm, int run, double cost) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "{\n  \"algorithm\": \"" << algorithm << "\",\n  \"run\": " << run << ",\n  \"cost\": " << cost
+        << ",\n  \"instrumented\": " << (VRP_PERF ? "true" : "false") << ",\n  \"wall_ms\": " << wallMs
+        << ",\n  \"evaluations\": " << evaluations << ",\n  \"evaluations_per_s\": " << evaluationsPerSecond()
+        << ",\n  \"time_to_best_ms\": " << timeToBestMs << ",\n  \"evaluations_to_best\": " << evaluationsToBest
+        << ",\n  \"stop_reason\": \"" << stopReason << "\",\n  \"steps\": " << steps
+        << ",\n  \"allocations\": " << allocations << ",\n  \"phases_ms\": {";
+    for (int p = 0; p < kPhaseCount; ++p) {
+        out << (p == 0 ? "" : ", ") << "\"" << phaseName(static_cast<Phase>(p)) << "\": " << phaseNs[p] * 1e-6;
+    }
+    out << "},\n  \"sa_acceptance\": [";
+    for (size_t i = 0; i < saAcceptance.size(); ++i) out << (i == 0 ? "" : ", ") << saAcceptance[i];
+    out << "]";
+    if (cycles >= 0) out << ",\n  \"cycles\": " << cycles;
+    if (cacheMisses >= 0) out << ",\n  \"cache_misses\": " << cacheMisses;
+    out << "\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Minimum z serii par odczytów zegara: tyle kosztuje odczyt wliczany w każdy pomiar fazy.
+static double calibrateClockOverhead() {
+    double best = 1e9;
+    for (int i = 0; i < 1000; ++i) {
+        auto a = std::chrono::steady_clock::now();
+        auto b = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(b - a).count());
+    }
+    return best;
+}
+
+static const double kClockOverheadNs = calibrateClockOverhead();
+
+double clockOverheadNs() { return kClockOverheadNs; }
+
+RunMetrics* currentMetrics() { return tlsMetrics; }
+
+long long threadAllocations() { return tlsAllocations; }
+
+#ifdef __linux__
+// Otwiera licznik sprzętowy bieżącego wątku (tylko przestrzeń użytkownika); -1 gdy niedostępny.
+static int openCounter(std::uint64_t config) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return fd;
+}
+
+static long long closeCounter(int fd) {
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long value = -1;
+    if (read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) value = -1;
+    close(fd);
+    return value;
+}
+#endif
+
+ScopedRunMetrics::ScopedRunMetrics(RunMetrics* metrics, bool hardware)
+    : metrics(metrics), previous(tlsMetrics), allocationsAtStart(tlsAllocations) {
+    tlsMetrics = metrics;
+#ifdef __linux__
+    if (metrics && hardware) {
+        cycleCounter = openCounter(PERF_COUNT_HW_CPU_CYCLES);
+        missCounter = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+    }
+#else
+    (void)hardware;
+#endif
+}
+
+ScopedRunMetrics::~ScopedRunMetrics() {
+    if (metrics) {
+        metrics->allocations += tlsAllocations - allocationsAtStart;
+        metrics->foldSamples();
+#ifdef __linux__
+        if (cycleCounter >= 0) metrics->cycles = closeCounter(cycleCounter);
+        if (missCounter >= 0) metrics->cacheMisses = closeCounter(missCounter);
+#endif
+    }
+    tlsMetrics = previous;
+}
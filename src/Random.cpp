@@ -1,18 +1,99 @@
 #include "Random.h"
 
 #include <random>
+#include <utility>
 
-std::mt19937& globalRng() {
-    static std::mt19937 gen(std::random_device{}());
+void Xoshiro256::reseed(std::uint64_t seed) {
+    std::uint64_t sm = seed;
+    for (auto& word : state) word = splitMix64(sm);
+}
+
+std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Skrót FNV-1a tekstu (stabilny między platformami, w przeciwieństwie do std::hash).
+static std::uint64_t hashText(const std::string& text) {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::uint64_t deriveStreamSeed(std::uint64_t seed, const std::string& instance, const std::string& algorithm,
+                               std::uint64_t run) {
+    std::uint64_t state = seed;
+    std::uint64_t mixed = splitMix64(state);
+    state = mixed ^ hashText(instance);
+    mixed = splitMix64(state);
+    state = mixed ^ hashText(algorithm);
+    mixed = splitMix64(state);
+    state = mixed ^ run;
+    return splitMix64(state);
+}
+
+std::uint64_t deriveSubstreamSeed(std::uint64_t base, std::uint64_t major, std::uint64_t minor) {
+    std::uint64_t state = base;
+    std::uint64_t mixed = splitMix64(state);
+    state = mixed ^ major;
+    mixed = splitMix64(state);
+    state = mixed ^ minor;
+    return splitMix64(state);
+}
+
+std::uint64_t entropySeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+}
+
+Xoshiro256& threadRng() {
+    thread_local Xoshiro256 gen(entropySeed());
     return gen;
 }
 
-int randInt(int min, int max) {
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(globalRng());
+ScopedRngStream::ScopedRngStream(std::uint64_t seed) : saved(threadRng()) {
+    threadRng().reseed(seed);
+}
+
+ScopedRngStream::~ScopedRngStream() {
+    threadRng() = saved;
+}
+
+void fillRandom(std::uint64_t* out, std::size_t count) {
+    Xoshiro256& gen = threadRng();
+    for (std::size_t i = 0; i < count; ++i) out[i] = gen();
 }
 
-double randUnit() {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    return dist(globalRng());
+void shuffleInPlace(int* data, std::size_t count) {
+    constexpr std::size_t kBatch = 32;
+    std::uint64_t words[kBatch];
+    std::size_t available = 0;  // pozostałe 32-bitowe połówki w paczce
+    for (std::size_t i = count; i > 1; --i) {
+        const std::uint32_t range = static_cast<std::uint32_t>(i);
+        std::uint32_t j;
+        while (true) {
+            if (available == 0) {
+                fillRandom(words, kBatch);
+                available = 2 * kBatch;
+            }
+            --available;
+            const std::uint64_t word = words[available / 2];
+            const std::uint32_t bits = available % 2 ? static_cast<std::uint32_t>(word >> 32)
+                                                     : static_cast<std::uint32_t>(word);
+            const std::uint64_t m = static_cast<std::uint64_t>(bits) * range;
+            // Odrzucenie tylko dla rzadkiego zakresu dolnego (Lemire); próg liczony leniwie.
+            if (static_cast<std::uint32_t>(m) < range &&
+                static_cast<std::uint32_t>(m) < (0u - range) % range) {
+                continue;
+            }
+            j = static_cast<std::uint32_t>(m >> 32);
+            break;
+        }
+        std::swap(data[i - 1], data[j]);
+    }
 }
@@ -0,0 +1,28 @@
+#include "Simd.h"
+
+static SimdLevel detectSimd() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel detectedSimd() {
+    static const SimdLevel level = detectSimd();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "avx512";
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Scalar: return "scalar";
+    }
+    return "scalar";
+}
+
+SimdLevel clampSimd(SimdLevel level) {
+    return static_cast<int>(level) <= static_cast<int>(detectedSimd()) ? level : detectedSimd();
+}
@@ -0,0 +1,166 @@
+#include "Split.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// Bufory algorytmu Split indeksowane pozycją w trasie 0..n (pozycja t to klient perm[t-1]).
+struct SplitWorkspace {
+    std::vector<int> load;        // skumulowane zapotrzebowanie do pozycji t
+    std::vector<double> along;    // długość trasy od pierwszego klienta do pozycji t
+    std::vector<double> fromDepot;  // odległość depo -> klient t
+    std::vector<double> toDepot;    // odległość klient t -> depo
+    std::vector<double> alpha;    // p[i] + d(0, t_{i+1}) - along[i+1] dla kandydatów w kolejce
+    std::vector<double> potential;  // koszty p[k][t] (wiersze dla kolejnych liczb tras)
+    std::vector<int> pred;        // poprzednik (początek trasy) dla p[k][t]
+    std::vector<int> queue;       // kolejka dwustronna indeksów kandydatów
+
+    void prepare(const Problem& problem, const std::vector<int>& perm, int rows) {
+        const int n = static_cast<int>(perm.size());
+        const size_t size = static_cast<size_t>(n) + 1;
+        load.resize(size);
+        along.resize(size);
+        fromDepot.resize(size);
+        toDepot.resize(size);
+        alpha.resize(size);
+        queue.resize(size);
+        potential.resize(size * rows);
+        pred.resize(size * rows);
+        const int depot = problem.depotId;
+        int cumLoad = 0;
+        double cumDist = 0.0;
+        int prev = perm.empty() ? depot : perm[0];
+        load[0] = 0;
+        along[0] = 0.0;
+        problem.distances.gather(depot, perm.data(), n, fromDepot.data() + 1);
+        problem.distances.visit([&](const auto& dist) {
+            for (int t = 1; t <= n; ++t) {
+                int customer = perm[t - 1];
+                cumLoad += problem.demands[customer];
+                cumDist += dist(prev, customer);
+                load[t] = cumLoad;
+                along[t] = cumDist;
+                toDepot[t] = dist(customer, depot);
+                prev = customer;
+            }
+        });
+    }
+};
+
+SplitWorkspace& workspace() {
+    thread_local SplitWorkspace ws;
+    return ws;
+}
+
+// Jedna warstwa Splitu: out[t] = min po i < t z in[i] + koszt trasy obsługującej pozycje i+1..t.
+// Kolejka trzyma kandydatów rosnąco wg indeksu i wartości alpha; czoło jest najlepszym dopuszczalnym.
+// Gdy in == out, warstwa liczy wariant bez limitu tras. allowOverload pozwala na jednoosobową
+// trasę przekraczającą pojemność (klient o zapotrzebowaniu > capacity), jak w dekoderze zachłannym.
+void splitLayer(SplitWorkspace& ws, int n, int capacity, const double* in, double* out, int* pred,
+                bool allowOverload) {
+    int* queue = ws.queue.data();
+    int head = 0;
+    int tail = 0;
+    for (int t = 1; t <= n; ++t) {
+        int candidate = t - 1;
+        if (in[candidate] < kInf) {
+            double a = in[candidate] + ws.fromDepot[candidate + 1] - ws.along[candidate + 1];
+            bool dominated = tail > head && ws.load[queue[tail - 1]] == ws.load[candidate] &&
+                             ws.alpha[queue[tail - 1]] <= a;
+            if (!dominated) {
+                while (tail > head && a <= ws.alpha[queue[tail - 1]]) --tail;
+                ws.alpha[candidate] = a;
+                queue[tail++] = candidate;
+            }
+        }
+        while (tail > head && ws.load[t] - ws.load[queue[head]] > capacity) ++head;
+        if (tail > head) {
+            int best = queue[head];
+            out[t] = ws.alpha[best] + ws.along[t] + ws.toDepot[t];
+            pred[t] = best;
+        } else if (allowOverload && in[t - 1] < kInf) {
+            out[t] = in[t - 1] + ws.fromDepot[t] + ws.toDepot[t];
+            pred[t] = t - 1;
+        } else {
+            out[t] = kInf;
+            pred[t] = -1;
+        }
+    }
+}
+
+// Wariant bez limitu tras; wynik w wierszu 0 (potential/pred).
+double splitUnbounded(SplitWorkspace& ws, int n, int capacity) {
+    double* p = ws.potential.data();
+    p[0] = 0.0;
+    splitLayer(ws, n, capacity, p, p, ws.pred.data(), true);
+    return p[n];
+}
+
+// Wariant z limitem tras: wiersz k to najlepsze podziały na dokładnie k tras.
+// Zwraca najlepszą liczbę tras (0 gdy brak dopuszczalnego podziału) i jej koszt.
+int splitBounded(SplitWorkspace& ws, int n, int capacity, int maxRoutes, double& bestCost) {
+    const size_t size = static_cast<size_t>(n) + 1;
+    double* rows = ws.potential.data();
+    std::fill(rows, rows + size, kInf);
+    rows[0] = 0.0;
+    bestCost = kInf;
+    int bestRoutes = 0;
+    for (int k = 1; k <= maxRoutes; ++k) {
+        double* out = rows + size * k;
+        out[0] = kInf;
+        splitLayer(ws, n, capacity, rows + size * (k - 1), out, ws.pred.data() + size * k, false);
+        if (out[n] < bestCost) {
+            bestCost = out[n];
+            bestRoutes = k;
+        }
+    }
+    return bestRoutes;
+}
+
+}  // namespace
+
+double splitCost(const Problem& problem, const std::vector<int>& perm, int maxRoutes) {
+    const int n = static_cast<int>(perm.size());
+    if (n == 0) return 0.0;
+    SplitWorkspace& ws = workspace();
+    if (maxRoutes > 0) {
+        ws.prepare(problem, perm, maxRoutes + 1);
+        double cost = kInf;
+        if (splitBounded(ws, n, problem.capacity, maxRoutes, cost) > 0) return cost;
+    } else {
+        ws.prepare(problem, perm, 1);
+    }
+    return splitUnbounded(ws, n, problem.capacity);
+}
+
+Solution splitDecode(const Problem& problem, const std::vector<int>& perm, int maxRoutes) {
+    Solution sol;
+    sol.perm = perm;
+    sol.cost = 0.0;
+    const int n = static_cast<int>(perm.size());
+    if (n == 0) return sol;
+    SplitWorkspace& ws = workspace();
+    const size_t size = static_cast<size_t>(n) + 1;
+    int routes = 0;
+    if (maxRoutes > 0) {
+        ws.prepare(problem, perm, maxRoutes + 1);
+        routes = splitBounded(ws, n, problem.capacity, maxRoutes, sol.cost);
+    } else {
+        ws.prepare(problem, perm, 1);
+    }
+    if (routes > 0) {
+        int t = n;
+        for (int k = routes; k > 0; --k) {
+            t = ws.pred[size * k + t];
+            sol.routeStarts.push_back(t);
+        }
+    } else {
+        sol.cost = splitUnbounded(ws, n, problem.capacity);
+        for (int t = n; t > 0; t = ws.pred[t]) sol.routeStarts.push_back(ws.pred[t]);
+    }
+    std::reverse(sol.routeStarts.begin(), sol.routeStarts.end());
+    return sol;
+}
@@ -1,5 +1,6 @@
 #include "Stats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <limits>
@@ -30,3 +31,90 @@ RunStats computeStats(const std::vector<double>& values) {
     double stdev = std::sqrt(variance);
     return RunStats{best, worst, avg, stdev};
 }
+
+void RunningStats::add(double value) {
+    ++count;
+    if (count == 1) {
+        min = value;
+        max = value;
+    } else {
+        if (value < min) min = value;
+        if (value > max) max = value;
+    }
+    double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+}
+
+double RunningStats::stddev() const {
+    if (count == 0) return 0.0;
+    return std::sqrt(m2 / static_cast<double>(count));
+}
+
+// Sortowanie przez wstawianie dla co najwyżej 5 wartości.
+static void sortSmall(double* values, int count) {
+    for (int i = 1; i < count; ++i) {
+        double value = values[i];
+        int j = i;
+        for (; j > 0 && values[j - 1] > value; --j) values[j] = values[j - 1];
+        values[j] = value;
+    }
+}
+
+P2Quantile::P2Quantile(double p) : p(p) {}
+
+void P2Quantile::add(double value) {
+    if (count < 5) {
+        heights[count++] = value;
+        if (count == 5) {
+            sortSmall(heights, 5);
+            for (int i = 0; i < 5; ++i) positions[i] = i;
+        }
+        return;
+    }
+    // Komórka k, do której wpada obserwacja; skrajne znaczniki przesuwamy do min/max.
+    int k;
+    if (value < heights[0]) {
+        heights[0] = value;
+        k = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (value >= heights[k + 1]) ++k;
+    }
+    for (int i = k + 1; i < 5; ++i) ++positions[i];
+    ++count;
+
+    const double fractions[5] = {0.0, p / 2.0, p, (1.0 + p) / 2.0, 1.0};
+    for (int i = 1; i <= 3; ++i) {
+        double desired = (count - 1) * fractions[i];
+        double delta = desired - positions[i];
+        if ((delta >= 1.0 && positions[i + 1] - positions[i] > 1) ||
+            (delta <= -1.0 && positions[i - 1] - positions[i] < -1)) {
+            int s = delta >= 0.0 ? 1 : -1;
+            // Interpolacja paraboliczna; gdy wychodzi poza sąsiadów - liniowa.
+            double left = positions[i] - positions[i - 1];
+            double right = positions[i + 1] - positions[i];
+            double candidate = heights[i] + s / static_cast<double>(positions[i + 1] - positions[i - 1]) *
+                                                ((left + s) * (heights[i + 1] - heights[i]) / right +
+                                                 (right - s) * (heights[i] - heights[i - 1]) / left);
+            if (heights[i - 1] < candidate && candidate < heights[i + 1]) {
+                heights[i] = candidate;
+            } else {
+                heights[i] += s * (heights[i + s] - heights[i]) / (positions[i + s] - positions[i]);
+            }
+            positions[i] += s;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (count == 0) return 0.0;
+    if (count >= 5) return heights[2];
+    double sorted[5];
+    std::copy(heights, heights + count, sorted);
+    sortSmall(sorted, count);
+    return sorted[static_cast<int>(std::lround(p * (count - 1)))];
+}
@@ -0,0 +1,90 @@
+#include "SwapDelta.h"
+
+#include <utility>
+
+SwapDeltaEvaluator::SwapDeltaEvaluator(const Problem& problem, std::vector<int> permutation, DecoderType decoder)
+    : problem(problem), decoder(decoder), perm(std::move(permutation)) {
+    if (decoder != DecoderType::Greedy) {
+        total = decodeCost(problem, perm, decoder);
+        return;
+    }
+    load.assign(perm.size(), 0);
+    prefixCost.assign(perm.size(), 0.0);
+    routeStart.assign(perm.size(), 0);
+    rebuildFrom(0);
+}
+
+void SwapDeltaEvaluator::rebuildFrom(int start) {
+    const int n = static_cast<int>(perm.size());
+    const int depot = problem.depotId;
+    int currentLoad = start > 0 ? load[start - 1] : 0;
+    double cost = start > 0 ? prefixCost[start - 1] : 0.0;
+    int prev = start > 0 ? perm[start - 1] : depot;
+    total = problem.distances.visit([&](const auto& dist) {
+        for (int p = start; p < n; ++p) {
+            int customer = perm[p];
+            int demand = problem.demands[customer];
+            if (currentLoad + demand > problem.capacity) {
+                cost += dist(prev, depot) + dist(depot, customer);
+                currentLoad = demand;
+                routeStart[p] = 1;
+            } else {
+                cost += dist(prev, customer);
+                currentLoad += demand;
+                routeStart[p] = p == 0;
+            }
+            load[p] = currentLoad;
+            prefixCost[p] = cost;
+            prev = customer;
+        }
+        return cost + dist(prev, depot);
+    });
+}
+
+double SwapDeltaEvaluator::applySwap(int i, int j) {
+    if (i > j) std::swap(i, j);
+    pendingFirst = i;
+    pendingSecond = j;
+    std::swap(perm[i], perm[j]);
+    if (decoder != DecoderType::Greedy) {
+        pendingCost = decodeCost(problem, perm, decoder);
+        return pendingCost;
+    }
+
+    const int n = static_cast<int>(perm.size());
+    const int depot = problem.depotId;
+    int currentLoad = i > 0 ? load[i - 1] : 0;
+    double cost = i > 0 ? prefixCost[i - 1] : 0.0;
+    int prev = i > 0 ? perm[i - 1] : depot;
+    pendingCost = problem.distances.visit([&](const auto& dist) {
+        for (int p = i; p < n; ++p) {
+            int customer = perm[p];
+            int demand = problem.demands[customer];
+            if (currentLoad + demand > problem.capacity) {
+                cost += dist(prev, depot) + dist(depot, customer);
+                // Za drugą zmienioną pozycją nowa trasa w tym samym miejscu co w starym podziale
+                // oznacza identyczną resztę rozwiązania - dodajemy jej koszt z tablic prefiksowych.
+                if (p > j && routeStart[p]) return cost + (total - prefixCost[p]);
+                currentLoad = demand;
+            } else {
+                cost += dist(prev, customer);
+                currentLoad += demand;
+            }
+            prev = customer;
+        }
+        return cost + dist(prev, depot);
+    });
+    return pendingCost;
+}
+
+void SwapDeltaEvaluator::commit() {
+    if (decoder != DecoderType::Greedy) {
+        total = pendingCost;
+        return;
+    }
+    rebuildFrom(pendingFirst);
+}
+
+void SwapDeltaEvaluator::undo() {
+    std::swap(perm[pendingFirst], perm[pendingSecond]);
+}
@@ -0,0 +1,157 @@
+#include "ThreadPool.h"
+
+#include <utility>
+
+// Indeks wątku w puli, która aktualnie wykonuje zadanie na tym wątku.
+static thread_local int currentWorker = 0;
+
+int ThreadPool::workerIndex() {
+    return currentWorker;
+}
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = threads > 0 ? threads : 1;
+    for (int i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<WorkerQueue>());
+    if (threadCount > 1) {
+        for (int i = 0; i < threadCount; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    try {
+        wait();
+    } catch (...) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    pending.fetch_add(1);
+    WorkerQueue& queue = *queues[nextQueue];
+    nextQueue = (nextQueue + 1) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    if (!workers.empty()) {
+        // Pusta sekcja krytyczna zapobiega zgubieniu powiadomienia przez wątek, który właśnie zasypia.
+        { std::lock_guard<std::mutex> lock(stateMutex); }
+        workAvailable.notify_one();
+    }
+}
+
+bool ThreadPool::takeTask(int index, std::function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    const int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; ++offset) {
+        WorkerQueue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runTask(std::function<void()>& task) {
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!firstError) firstError = std::current_exception();
+    }
+    task = nullptr;
+    if (pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        allDone.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentWorker = index;
+    std::function<void()> task;
+    while (true) {
+        if (takeTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (stopping) return;
+        workAvailable.wait(lock, [&] {
+            if (stopping) return true;
+            for (const auto& queue : queues) {
+                std::lock_guard<std::mutex> queueLock(queue->mutex);
+                if (!queue->tasks.empty()) return true;
+            }
+            return false;
+        });
+        if (stopping) return;
+    }
+}
+
+void ThreadPool::wait() {
+    if (workers.empty()) {
+        // Wątek wywołujący może należeć do innej puli - na czas zadań jest wątkiem 0 tej puli.
+        int savedWorker = currentWorker;
+        currentWorker = 0;
+        std::function<void()> task;
+        while (takeTask(0, task)) runTask(task);
+        currentWorker = savedWorker;
+    } else {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allDone.wait(lock, [&] { return pending.load() == 0; });
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        std::swap(error, firstError);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    for (int i = 0; i < count; ++i) {
+        submit([&fn, i] { fn(i); });
+    }
+    wait();
+}
+
+void Barrier::arriveAndWait(const std::function<void()>& onLast) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const unsigned long long round = generation;
+    if (++waiting < parties) {
+        released.wait(lock, [&] { return generation != round; });
+        return;
+    }
+    waiting = 0;
+    if (onLast) {
+        try {
+            onLast();
+        } catch (...) {
+            // Pozostali i tak są zwalniani - inaczej czekaliby na rundę, która się nie skończy.
+            ++generation;
+            lock.unlock();
+            released.notify_all();
+            throw;
+        }
+    }
+    ++generation;
+    lock.unlock();
+    released.notify_all();
+}
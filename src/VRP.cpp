@@ -1,92 +1,53 @@
 #include "VRP.h"
 
+#include "Random.h"
+#include "Split.h"
+
 #include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <cstddef>
 #include <fstream>
-#include <random>
 #include <sstream>
-#include <stdexcept>
-#include <unordered_map>
 
 static double euclideanDistance(double x1, double y1, double x2, double y2) {
     double dx = x1 - x2;
     double dy = y1 - y2;
-    double dist = std::sqrt(dx * dx + dy * dy);
-    return std::round(dist);
-}
-
-static std::mt19937& rng() {
-    static std::mt19937 gen(std::random_device{}());
-    return gen;
+    return std::sqrt(dx * dx + dy * dy);
 }
 
-Problem parseVRP(const std::string& path) {
-    Problem problem{};
-    std::ifstream in(path);
-    if (!in.is_open()) {
-        throw std::runtime_error("Nie można otworzyć pliku VRP: " + path);
-    }
-    std::string line;
-    while (std::getline(in, line)) {
-        if (line.find("DIMENSION") != std::string::npos) {
-            std::stringstream ss(line);
-            std::string dummy; char colon;
-            ss >> dummy >> colon >> problem.dimension;
-        }
-        if (line.find("CAPACITY") != std::string::npos) {
-            std::stringstream ss(line);
-            std::string dummy; char colon;
-            ss >> dummy >> colon >> problem.capacity;
-        }
-        if (line.find("NODE_COORD_SECTION") != std::string::npos) {
-            break;
-        }
-    }
-    std::unordered_map<int, std::pair<double, double>> coords;
-    while (std::getline(in, line)) {
-        if (line.find("DEMAND_SECTION") != std::string::npos) break;
-        if (line.empty()) continue;
-        std::stringstream ss(line);
-        int id; double x, y;
-        ss >> id >> x >> y;
-        coords[id] = {x, y};
-    }
-    std::unordered_map<int, int> demands;
-    while (std::getline(in, line)) {
-        if (line.find("DEPOT_SECTION") != std::string::npos) break;
-        if (line.empty()) continue;
-        std::stringstream ss(line);
-        int id, dem;
-        ss >> id >> dem;
-        demands[id] = dem;
-    }
-    while (std::getline(in, line)) {
-        std::stringstream ss(line);
-        int depot;
-        ss >> depot;
-        if (depot == -1) break;
-        problem.depotId = depot;
-        break;
-    }
-    if (problem.depotId == 0) problem.depotId = 1;
-
-    problem.nodes.reserve(problem.dimension);
-    for (int id = 1; id <= problem.dimension; ++id) {
-        double x = coords.count(id) ? coords[id].first : 0.0;
-        double y = coords.count(id) ? coords[id].second : 0.0;
-        int dem = demands.count(id) ? demands[id] : 0;
-        problem.nodes.push_back(Node{id, x, y, dem});
+void buildDistanceMatrix(Problem& problem, const DistanceSettings& settings) {
+    if (problem.edgeWeightType == EdgeWeightType::Explicit) return;
+    const bool ceiling = problem.edgeWeightType == EdgeWeightType::Ceil2D;
+    if (!preferDenseDistances(problem.dimension + 1, settings)) {
+        problem.distances.computeOnDemand(problem.xs.data(), problem.ys.data(), problem.dimension + 1, ceiling);
+        return;
     }
-    problem.distances.assign(problem.dimension + 1, std::vector<double>(problem.dimension + 1, 0.0));
+    problem.distances.resize(problem.dimension + 1);
     for (int i = 1; i <= problem.dimension; ++i) {
         for (int j = 1; j <= problem.dimension; ++j) {
-            const Node& a = problem.nodes[i - 1];
-            const Node& b = problem.nodes[j - 1];
-            problem.distances[i][j] = euclideanDistance(a.x, a.y, b.x, b.y);
+            double dist = euclideanDistance(problem.xs[i], problem.ys[i], problem.xs[j], problem.ys[j]);
+            problem.distances.set(i, j, ceiling ? std::ceil(dist) : std::round(dist));
         }
     }
-    return problem;
+}
+
+int vehiclesFromName(const std::string& name) {
+    size_t pos = name.rfind("-k");
+    if (pos == std::string::npos) return 0;
+    int value = 0;
+    for (size_t i = pos + 2; i < name.size() && std::isdigit(static_cast<unsigned char>(name[i])); ++i) {
+        value = value * 10 + (name[i] - '0');
+    }
+    return value;
+}
+
+DecoderType parseDecoderType(const std::string& name, bool fleetLimit) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "split") return fleetLimit ? DecoderType::SplitBounded : DecoderType::Split;
+    return DecoderType::Greedy;
 }
 
 double readOptimalCost(const std::string& path) {
@@ -108,49 +69,111 @@ double readOptimalCost(const std::string& path) {
 }
 
 double evaluateSolution(const Problem& problem, const Solution& solution) {
-    double total = 0.0;
-    for (const auto& route : solution.routes) {
-        int prev = problem.depotId;
-        for (int nodeId : route) {
-            total += problem.distances[prev][nodeId];
-            prev = nodeId;
+    const int n = static_cast<int>(solution.perm.size());
+    const int routeCount = static_cast<int>(solution.routeStarts.size());
+    if (problem.distances.onDemand()) {
+        // Trasy liczone wsadowo jądrem SIMD.
+        double total = 0.0;
+        for (int r = 0; r < routeCount; ++r) {
+            int begin = solution.routeStarts[r];
+            int end = r + 1 < routeCount ? solution.routeStarts[r + 1] : n;
+            total += problem.distances.routeLength(problem.depotId, solution.perm.data() + begin, end - begin);
         }
-        total += problem.distances[prev][problem.depotId];
+        return total;
     }
-    return total;
+    return problem.distances.visit([&](const auto& dist) {
+        double total = 0.0;
+        for (int r = 0; r < routeCount; ++r) {
+            int begin = solution.routeStarts[r];
+            int end = r + 1 < routeCount ? solution.routeStarts[r + 1] : n;
+            int prev = problem.depotId;
+            for (int idx = begin; idx < end; ++idx) {
+                int nodeId = solution.perm[idx];
+                total += dist(prev, nodeId);
+                prev = nodeId;
+            }
+            total += dist(prev, problem.depotId);
+        }
+        return total;
+    });
 }
 
-Solution decodePermutation(const Problem& problem, const std::vector<int>& permutation) {
+Solution decodePermutation(const Problem& problem, const std::vector<int>& permutation, DecoderType decoder) {
+    if (decoder != DecoderType::Greedy) {
+        return splitDecode(problem, permutation, decoder == DecoderType::SplitBounded ? problem.vehicles : 0);
+    }
     Solution sol;
+    sol.perm = permutation;
     sol.cost = 0.0;
-    std::vector<int> currentRoute;
     int currentLoad = 0;
-    for (int customer : permutation) {
-        int demand = problem.nodes[customer - 1].demand;
-        if (currentLoad + demand > problem.capacity) {
-            sol.routes.push_back(currentRoute);
-            currentRoute.clear();
+    const int n = static_cast<int>(permutation.size());
+    for (int idx = 0; idx < n; ++idx) {
+        int demand = problem.demands[permutation[idx]];
+        if (idx == 0 || currentLoad + demand > problem.capacity) {
+            sol.routeStarts.push_back(idx);
             currentLoad = 0;
         }
-        currentRoute.push_back(customer);
         currentLoad += demand;
     }
-    if (!currentRoute.empty()) {
-        sol.routes.push_back(currentRoute);
-    }
     sol.cost = evaluateSolution(problem, sol);
     return sol;
 }
 
+double decodeCost(const Problem& problem, const std::vector<int>& permutation, DecoderType decoder) {
+    if (decoder != DecoderType::Greedy) {
+        return splitCost(problem, permutation, decoder == DecoderType::SplitBounded ? problem.vehicles : 0);
+    }
+    return greedyCost(problem, permutation.data(), static_cast<int>(permutation.size()));
+}
+
+double greedyCost(const Problem& problem, const int* perm, int length) {
+    return problem.distances.visit([&](const auto& dist) {
+        const int depot = problem.depotId;
+        double total = 0.0;
+        int currentLoad = 0;
+        int prev = depot;
+        for (int k = 0; k < length; ++k) {
+            int customer = perm[k];
+            int demand = problem.demands[customer];
+            if (currentLoad + demand > problem.capacity) {
+                total += dist(prev, depot);
+                prev = depot;
+                currentLoad = 0;
+            }
+            total += dist(prev, customer);
+            currentLoad += demand;
+            prev = customer;
+        }
+        return total + dist(prev, depot);
+    });
+}
+
+std::vector<std::vector<int>> expandRoutes(const Solution& solution) {
+    std::vector<std::vector<int>> routes;
+    routes.reserve(solution.routeStarts.size());
+    const int routeCount = static_cast<int>(solution.routeStarts.size());
+    for (int r = 0; r < routeCount; ++r) {
+        auto begin = solution.perm.begin() + solution.routeStarts[r];
+        auto end = r + 1 < routeCount ? solution.perm.begin() + solution.routeStarts[r + 1] : solution.perm.end();
+        routes.emplace_back(begin, end);
+    }
+    return routes;
+}
+
 std::vector<int> randomPermutation(const Problem& problem) {
     std::vector<int> perm;
     perm.reserve(problem.dimension - 1);
+    fillRandomPermutation(problem, perm);
+    return perm;
+}
+
+void fillRandomPermutation(const Problem& problem, std::vector<int>& perm) {
+    perm.clear();
     for (const auto& node : problem.nodes) {
         if (node.id == problem.depotId) {
             continue;
         }
         perm.push_back(node.id);
     }
-    std::shuffle(perm.begin(), perm.end(), rng());
-    return perm;
+    shuffleInPlace(perm.data(), perm.size());
 }
@@ -0,0 +1,320 @@
+// Parser plików VRPLIB: plik mapowany do pamięci (mmap), tokenizacja bez kopiowania, liczby przez
+// std::from_chars, wartości wpisywane od razu do tablic SoA problemu i macierzy (EXPLICIT).
+#include "VRP.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VRP_HAVE_MMAP 1
+#endif
+
+namespace {
+
+// Zawartość pliku tylko do odczytu: mmap, a gdzie go nie ma - bufor wczytany strumieniem.
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string& path) {
+#ifdef VRP_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Nie można otworzyć pliku VRP: " + path);
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* addr = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+                data = static_cast<const char*>(addr);
+                length = static_cast<std::size_t>(info.st_size);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        if (mapped) return;
+#endif
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) throw std::runtime_error("Nie można otworzyć pliku VRP: " + path);
+        fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = fallback.data();
+        length = fallback.size();
+    }
+    ~MappedFile() {
+#ifdef VRP_HAVE_MMAP
+        if (mapped) ::munmap(const_cast<char*>(data), length);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+
+  private:
+    const char* data = nullptr;
+    std::size_t length = 0;
+    bool mapped = false;
+    std::string fallback;
+};
+
+// Format macierzy w EDGE_WEIGHT_SECTION.
+enum class WeightFormat { None, FullMatrix, LowerRow, LowerDiagRow, UpperRow, UpperDiagRow };
+
+// Czytnik VRPLIB nad zakresem znaków pliku. Błędy zgłasza wyjątkiem z numerem linii.
+class VrplibReader {
+  public:
+    VrplibReader(const char* begin, const char* end, const std::string& path)
+        : first(begin), pos(begin), last(end), path(path) {}
+
+    void read(Problem& problem);
+
+  private:
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    static bool isSpace(char c) { return isBlank(c) || c == '\n'; }
+    static bool isKeyChar(char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    void skipSpace() {
+        while (pos < last && isSpace(*pos)) ++pos;
+    }
+    // Słowo kluczowe na początku linii (litery, cyfry, '_').
+    std::string_view keyword() {
+        skipSpace();
+        const char* start = pos;
+        while (pos < last && isKeyChar(*pos)) ++pos;
+        return {start, static_cast<std::size_t>(pos - start)};
+    }
+    // Wartość po "KLUCZ :" do końca linii, bez skrajnych odstępów.
+    std::string_view headerValue() {
+        while (pos < last && isBlank(*pos)) ++pos;
+        if (pos < last && *pos == ':') ++pos;
+        while (pos < last && isBlank(*pos)) ++pos;
+        const char* start = pos;
+        while (pos < last && *pos != '\n') ++pos;
+        const char* stop = pos;
+        while (stop > start && isBlank(stop[-1])) --stop;
+        return {start, static_cast<std::size_t>(stop - start)};
+    }
+    template <typename T>
+    T number(const char* what) {
+        skipSpace();
+        T value{};
+        auto [next, error] = std::from_chars(pos, last, value);
+        if (error != std::errc() || (next < last && !isSpace(*next))) fail(std::string("oczekiwano liczby (") + what + ")");
+        pos = next;
+        return value;
+    }
+    template <typename T>
+    T headerNumber(std::string_view key) {
+        std::string_view text = headerValue();
+        T value{};
+        auto [next, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc() || next != text.data() + text.size()) {
+            fail("niepoprawna wartość " + std::string(key) + ": '" + std::string(text) + "'");
+        }
+        return value;
+    }
+    // Id węzła z zakresu 1..dimension.
+    int nodeId(const char* section) {
+        int id = number<int>(section);
+        if (id < 1 || id > dimension) fail(std::string("id węzła ") + std::to_string(id) + " poza zakresem w " + section);
+        return id;
+    }
+    [[noreturn]] void fail(const std::string& message) const {
+        long line = 1 + std::count(first, pos, '\n');
+        throw std::runtime_error(path + ":" + std::to_string(line) + ": " + message);
+    }
+    void requireDimension(std::string_view section) const {
+        if (dimension <= 0) fail(std::string(section) + " przed DIMENSION");
+    }
+
+    void readCoordinates(Problem& problem, const char* section, bool primary);
+    void readDemands(Problem& problem);
+    void readDepots(Problem& problem);
+    void readEdgeWeights(Problem& problem);
+
+    const char* first;
+    const char* pos;
+    const char* last;
+    const std::string& path;
+    int dimension = 0;
+    WeightFormat format = WeightFormat::None;
+    bool haveCoords = false;
+    bool haveDemands = false;
+    bool haveWeights = false;
+};
+
+void VrplibReader::read(Problem& problem) {
+    bool haveWeightType = false;
+    while (true) {
+        std::string_view key = keyword();
+        if (key.empty() && pos >= last) break;
+        if (key.empty() || (key[0] >= '0' && key[0] <= '9')) {
+            pos -= key.size();
+            fail("oczekiwano słowa kluczowego lub sekcji, jest '" + std::string(headerValue()) + "'");
+        }
+        if (key == "EOF") break;
+        if (key == "NAME") {
+            problem.name = std::string(headerValue());
+        } else if (key == "DIMENSION") {
+            dimension = headerNumber<int>(key);
+            if (dimension < 1) fail("DIMENSION musi być dodatnie");
+            problem.dimension = dimension;
+            problem.demands.assign(dimension + 1, 0);
+            problem.xs.assign(dimension + 1, 0.0);
+            problem.ys.assign(dimension + 1, 0.0);
+        } else if (key == "CAPACITY") {
+            problem.capacity = headerNumber<int>(key);
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            std::string_view type = headerValue();
+            if (type == "EUC_2D") problem.edgeWeightType = EdgeWeightType::Euc2D;
+            else if (type == "CEIL_2D") problem.edgeWeightType = EdgeWeightType::Ceil2D;
+            else if (type == "EXPLICIT") problem.edgeWeightType = EdgeWeightType::Explicit;
+            else fail("nieobsługiwany EDGE_WEIGHT_TYPE: " + std::string(type) + " (dozwolone: EUC_2D, CEIL_2D, EXPLICIT)");
+            haveWeightType = true;
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            std::string_view text = headerValue();
+            if (text == "FULL_MATRIX") format = WeightFormat::FullMatrix;
+            else if (text == "LOWER_ROW") format = WeightFormat::LowerRow;
+            else if (text == "LOWER_DIAG_ROW") format = WeightFormat::LowerDiagRow;
+            else if (text == "UPPER_ROW") format = WeightFormat::UpperRow;
+            else if (text == "UPPER_DIAG_ROW") format = WeightFormat::UpperDiagRow;
+            else if (text != "FUNCTION") fail("nieobsługiwany EDGE_WEIGHT_FORMAT: " + std::string(text));
+        } else if (key == "NODE_COORD_SECTION") {
+            readCoordinates(problem, "NODE_COORD_SECTION", true);
+        } else if (key == "DISPLAY_DATA_SECTION") {
+            readCoordinates(problem, "DISPLAY_DATA_SECTION", false);
+        } else if (key == "DEMAND_SECTION") {
+            readDemands(problem);
+        } else if (key == "DEPOT_SECTION") {
+            readDepots(problem);
+        } else if (key == "EDGE_WEIGHT_SECTION") {
+            if (problem.edgeWeightType != EdgeWeightType::Explicit || !haveWeightType) {
+                fail("EDGE_WEIGHT_SECTION wymaga EDGE_WEIGHT_TYPE : EXPLICIT");
+            }
+            readEdgeWeights(problem);
+        } else if (key.size() > 8 && key.substr(key.size() - 8) == "_SECTION") {
+            fail("nieobsługiwana sekcja " + std::string(key));
+        } else {
+            headerValue();  // pozostałe pola nagłówka (TYPE, COMMENT, ...) nie są potrzebne
+        }
+    }
+    if (dimension <= 0) fail("brak DIMENSION");
+    if (!haveDemands) fail("brak DEMAND_SECTION");
+    if (problem.edgeWeightType == EdgeWeightType::Explicit) {
+        if (!haveWeights) fail("brak EDGE_WEIGHT_SECTION dla EDGE_WEIGHT_TYPE : EXPLICIT");
+    } else if (!haveCoords) {
+        fail("brak NODE_COORD_SECTION");
+    }
+}
+
+// Sekcja "id x y" dla każdego węzła; DISPLAY_DATA_SECTION nie nadpisuje współrzędnych z NODE_COORD_SECTION.
+void VrplibReader::readCoordinates(Problem& problem, const char* section, bool primary) {
+    requireDimension(section);
+    const bool store = primary || !haveCoords;
+    std::vector<char> seen(dimension + 1, 0);
+    for (int i = 0; i < dimension; ++i) {
+        int id = nodeId(section);
+        if (seen[id]) fail(std::string("powtórzony węzeł ") + std::to_string(id) + " w " + section);
+        seen[id] = 1;
+        double x = number<double>(section);
+        double y = number<double>(section);
+        if (store) {
+            problem.xs[id] = x;
+            problem.ys[id] = y;
+        }
+    }
+    if (primary) haveCoords = true;
+}
+
+void VrplibReader::readDemands(Problem& problem) {
+    requireDimension("DEMAND_SECTION");
+    std::vector<char> seen(dimension + 1, 0);
+    for (int i = 0; i < dimension; ++i) {
+        int id = nodeId("DEMAND_SECTION");
+        if (seen[id]) fail("powtórzony węzeł " + std::to_string(id) + " w DEMAND_SECTION");
+        seen[id] = 1;
+        problem.demands[id] = number<int>("DEMAND_SECTION");
+    }
+    haveDemands = true;
+}
+
+// Lista depo zakończona -1; obsługiwane jest jedno depo.
+void VrplibReader::readDepots(Problem& problem) {
+    requireDimension("DEPOT_SECTION");
+    int depots = 0;
+    while (true) {
+        int id = number<int>("DEPOT_SECTION");
+        if (id == -1) break;
+        if (id < 1 || id > dimension) fail("id depo " + std::to_string(id) + " poza zakresem");
+        if (++depots > 1) fail("obsługiwane jest tylko jedno depo");
+        problem.depotId = id;
+    }
+}
+
+// Macierz w formacie EDGE_WEIGHT_FORMAT; wartości trafiają symetrycznie do macierzy odległości.
+void VrplibReader::readEdgeWeights(Problem& problem) {
+    requireDimension("EDGE_WEIGHT_SECTION");
+    if (format == WeightFormat::None) fail("EDGE_WEIGHT_SECTION bez EDGE_WEIGHT_FORMAT");
+    problem.distances.resize(dimension + 1);
+    for (int i = 0; i < dimension; ++i) {
+        int from = 0, to = dimension;
+        switch (format) {
+            case WeightFormat::FullMatrix: break;
+            case WeightFormat::LowerRow: to = i; break;
+            case WeightFormat::LowerDiagRow: to = i + 1; break;
+            case WeightFormat::UpperRow: from = i + 1; break;
+            case WeightFormat::UpperDiagRow: from = i; break;
+            case WeightFormat::None: break;
+        }
+        for (int j = from; j < to; ++j) {
+            double value = number<double>("EDGE_WEIGHT_SECTION");
+            if (i == j) continue;
+            problem.distances.set(i + 1, j + 1, value);
+            if (format != WeightFormat::FullMatrix) problem.distances.set(j + 1, i + 1, value);
+        }
+    }
+    haveWeights = true;
+}
+
+}  // namespace
+
+Problem readVrplib(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    Problem problem{};
+    {
+        MappedFile file(path);
+        VrplibReader(file.begin(), file.end(), path).read(problem);
+    }
+    if (problem.depotId == 0) problem.depotId = 1;
+    if (problem.name.empty()) {
+        size_t slash = path.find_last_of("/\\");
+        std::string file = slash == std::string::npos ? path : path.substr(slash + 1);
+        problem.name = file.substr(0, file.rfind('.'));
+    }
+    problem.vehicles = vehiclesFromName(problem.name);
+    problem.nodes.resize(problem.dimension);
+    for (int id = 1; id <= problem.dimension; ++id) {
+        problem.nodes[id - 1] = Node{id, problem.xs[id], problem.ys[id], problem.demands[id]};
+    }
+    problem.parseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return problem;
+}
+
+Problem parseVRP(const std::string& path, const DistanceSettings& distances) {
+    Problem problem = readVrplib(path);
+    buildDistanceMatrix(problem, distances);
+    buildCandidateLists(problem, kDefaultCandidates);
+    return problem;
+}
@@ -1,16 +1,140 @@
 #include "Algorithms.h"
 #include "Config.h"
+#include "Curve.h"
 #include "Logger.h"
+#include "Perf.h"
+#include "Random.h"
 #include "Stats.h"
+#include "ThreadPool.h"
 #include "VRP.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+// Dane jednej instancji: problem, liczby uruchomień i miejsca na wyniki kolejnych runów.
+struct InstanceJob {
+    std::string baseName;
+    std::string vrpPath;
+    Problem problem;
+    double loadMs;  // wczytanie instancji razem z macierzą odległości i listami kandydatów
+    double optimalCost;
+    std::filesystem::path logDir;
+    int randomRuns;
+    int greedyRuns;
+    int saRuns;
+    int eaRuns;
+    std::vector<double> randomScores;
+    std::vector<double> greedyScores;
+    std::vector<double> saScores;
+    std::vector<double> eaScores;
+    // Pomiary kolejnych runów (czas, liczba ocen, czas i oceny do najlepszego wyniku).
+    std::vector<RunMetrics> randomMetrics;
+    std::vector<RunMetrics> greedyMetrics;
+    std::vector<RunMetrics> saMetrics;
+    std::vector<RunMetrics> eaMetrics;
+    // Krzywe zbiorcze (tylko w trybie log_mode=aggregate).
+    std::unique_ptr<CurveAggregator> randomCurves;
+    std::unique_ptr<CurveAggregator> greedyCurves;
+    std::unique_ptr<CurveAggregator> saCurves;
+    std::unique_ptr<CurveAggregator> eaCurves;
+};
+
+// Ustawienia logów przebiegów wspólne dla wszystkich runów.
+struct LogSettings {
+    LogFormat format;
+    LogPolicy policy;
+    int every;
+    bool aggregate;   // tryb aggregate: krzywe zbiorcze zamiast pliku na każdy run
+    int rawRuns;      // w trybie aggregate: liczba runów z pełnym logiem
+};
+
+// Algorytm uruchamiany przez runner.
+using AlgorithmFn = Solution (*)(const Problem&, const Config&, CSVLogger&, Budget&);
+
+// Wykonuje jeden run algorytmu z własnym strumieniem losowym i budżetem z konfiguracji (z celem
+// optimum * (1 + stop_target_gap), gdy optimum jest znane); log trafia
+// do pliku `<alg>_run_<run>` i/lub do krzywej agregatora, a pomiary do `metrics` (i do
+// `<alg>_run_<run>.json` dla runów z pełnym logiem). Zwraca koszt rozwiązania.
+static double executeRun(const Config& cfg, const LogSettings& logs, const InstanceJob& job, const char* alg,
+                         const char* header, int run, CurveAggregator* curves, AlgorithmFn algorithm,
+                         RunMetrics& metrics) {
+    ScopedRngStream stream(deriveStreamSeed(cfg.seed, job.baseName, alg, run));
+    const bool fullLog = !logs.aggregate || run < logs.rawRuns;
+    const std::string runName = std::string(alg) + "_run_" + std::to_string(run);
+    std::unique_ptr<CSVLogger> logger;
+    if (fullLog) {
+        std::string logPath = (job.logDir / (runName + logExtension(logs.format))).string();
+        logger = std::make_unique<CSVLogger>(logPath, header, logs.format);
+        logger->setPolicy(logs.policy, logs.every);
+    } else {
+        logger = std::make_unique<CSVLogger>();
+    }
+    RunCurve curve;
+    if (curves) {
+        curve.stride = curves->stride();
+        logger->attachCurve(&curve);
+    }
+    double cost;
+    {
+        ScopedRunMetrics scope(&metrics, cfg.perfCounters);
+        Budget budget(cfg);
+        if (cfg.stopTargetGap >= 0.0 && job.optimalCost > 0) budget.setTarget(job.optimalCost * (1.0 + cfg.stopTargetGap));
+        cost = algorithm(job.problem, cfg, *logger, budget).cost;
+        metrics.wallMs = budget.elapsedMs();
+        metrics.evaluations = budget.evaluations();
+        metrics.timeToBestMs = budget.timeToBestMs();
+        metrics.evaluationsToBest = budget.evaluationsToBest();
+        metrics.stopReason = stopReasonName(budget.stopReason());
+        metrics.steps = budget.stepCount();
+    }
+    if (curves) curves->submit(run, std::move(curve.best));
+    if (fullLog && cfg.runMetrics) metrics.writeJson((job.logDir / (runName + ".json")).string(), alg, run, cost);
+    metrics.saAcceptance = std::vector<double>();  // do podsumowania potrzebne są tylko liczniki
+    return cost;
+}
+
+// Czasy runów jednego algorytmu w podsumowaniu.
+struct TimingSummary {
+    double meanMs = 0.0;          // średni czas runu
+    double evalsPerSecond = 0.0;  // przepustowość ocen
+    double meanTimeToBestMs = 0.0;
+    double meanEvaluationsToBest = 0.0;
+};
+
+static TimingSummary timingSummary(const std::vector<RunMetrics>& runs) {
+    TimingSummary summary;
+    double wallMs = 0.0;
+    long long evaluations = 0;
+    for (const auto& metrics : runs) {
+        wallMs += metrics.wallMs;
+        evaluations += metrics.evaluations;
+        summary.meanTimeToBestMs += metrics.timeToBestMs;
+        summary.meanEvaluationsToBest += static_cast<double>(metrics.evaluationsToBest);
+    }
+    if (!runs.empty()) {
+        summary.meanMs = wallMs / static_cast<double>(runs.size());
+        summary.meanTimeToBestMs /= static_cast<double>(runs.size());
+        summary.meanEvaluationsToBest /= static_cast<double>(runs.size());
+    }
+    summary.evalsPerSecond = wallMs > 0.0 ? static_cast<double>(evaluations) / (wallMs * 1e-3) : 0.0;
+    return summary;
+}
+
+// Pojedyncze uruchomienie algorytmu jako zadanie dla puli wątków.
+struct RunTask {
+    double estimatedWork;         // szacowany koszt (do kolejności zgłaszania)
+    std::function<void()> body;   // wykonanie runu i zapis wyniku do slotu
+};
+
 int main(int argc, char** argv) {
     std::string configPath = "config.ini";
     if (argc > 1) {
@@ -19,17 +143,39 @@ int main(int argc, char** argv) {
 
     ConfigLoader loader;
     Config cfg;
+    LogSettings logs;
     try {
         cfg = loader.load(configPath);
+        logs.format = parseLogFormat(cfg.logFormat);
+        logs.policy = parseLogPolicy(cfg.logPolicy);
+        if (cfg.logMode != "per_run" && cfg.logMode != "aggregate") {
+            throw std::invalid_argument("Nieznany tryb logów: " + cfg.logMode + " (dozwolone: per_run, aggregate)");
+        }
     } catch (const std::exception& ex) {
         std::cerr << "Błąd konfiguracji: " << ex.what() << "\n";
         return 1;
     }
+    for (const std::string& warning : configWarnings(cfg)) std::cerr << "Uwaga: " << warning << "\n";
+    logs.every = cfg.logEvery;
+    logs.aggregate = cfg.logMode == "aggregate";
+    logs.rawRuns = cfg.rawLogRuns;
     std::filesystem::create_directories(cfg.logDir);
+    if (cfg.seed == 0) {
+        cfg.seed = entropySeed();
+        std::cout << "Ziarno (seed): " << cfg.seed << "\n";
+    }
 
     std::vector<std::string> summaryCsv;
-    summaryCsv.push_back("instance,optimal,random_runs,random_best,random_worst,random_avg,random_std,greedy_runs,greedy_best,greedy_worst,greedy_avg,greedy_std,ea_runs,ea_best,ea_worst,ea_avg,ea_std,sa_runs,sa_best,sa_worst,sa_avg,sa_std");
+    summaryCsv.push_back("instance,optimal,random_runs,random_best,random_worst,random_avg,random_std,greedy_runs,greedy_best,greedy_worst,greedy_avg,greedy_std,ea_runs,ea_best,ea_worst,ea_avg,ea_std,sa_runs,sa_best,sa_worst,sa_avg,sa_std,random_evals_to_best,greedy_evals_to_best,ea_evals_to_best,sa_evals_to_best,distance_mode");
+    // Czasy osobno, żeby summary.csv przy tym samym ziarnie był powtarzalny (czasy runów są też w runs.csv).
+    std::vector<std::string> timingCsv;
+    timingCsv.push_back("instance,random_time_ms,random_evals_per_s,greedy_time_ms,greedy_evals_per_s,ea_time_ms,ea_evals_per_s,sa_time_ms,sa_evals_per_s,random_time_to_best_ms,greedy_time_to_best_ms,ea_time_to_best_ms,sa_time_to_best_ms,parse_ms,load_ms");
+    // Wiersz na każdy run: koszt, czas, oceny, moment znalezienia najlepszego wyniku i powód zakończenia.
+    std::vector<std::string> runsCsv;
+    runsCsv.push_back("instance,algorithm,run,cost,time_ms,evaluations,time_to_best_ms,evals_to_best,stop_reason,steps");
 
+    // Stała kolejność instancji (kolejność directory_iterator nie jest określona).
+    std::vector<std::filesystem::path> vrpFiles;
     for (const auto& entry : std::filesystem::directory_iterator(cfg.inputDirectory)) {
         if (!entry.is_regular_file()) {
             continue;
@@ -37,66 +183,113 @@ int main(int argc, char** argv) {
         if (entry.path().extension() != ".vrp") {
             continue;
         }
-        std::string vrpPath = entry.path().string();
-        std::string baseName = entry.path().stem().string();
+        vrpFiles.push_back(entry.path());
+    }
+    std::sort(vrpFiles.begin(), vrpFiles.end());
+
+    // deque: adresy zadań nie zmieniają się po dodaniu kolejnych instancji.
+    std::deque<InstanceJob> jobs;
+    for (const auto& path : vrpFiles) {
+        std::string vrpPath = path.string();
+        std::string baseName = path.stem().string();
         std::string optPath = (std::filesystem::path(cfg.optimalDirectory) / (baseName + ".sol")).string();
         Problem problem;
+        auto loadStart = std::chrono::steady_clock::now();
         try {
-            problem = parseVRP(vrpPath);
+            problem = parseVRP(vrpPath, DistanceSettings{parseDistanceMode(cfg.distanceMode), cfg.distanceDenseLimitMb});
         } catch (const std::exception& ex) {
             std::cerr << "Błąd wczytywania VRP (" << vrpPath << "): " << ex.what() << "\n";
             continue;
         }
-        double optimalCost = readOptimalCost(optPath);
-        std::filesystem::path instLogDir = std::filesystem::path(cfg.logDir) / baseName;
-        std::filesystem::create_directories(instLogDir);
-
-        int randomRuns = cfg.randomRuns;
-        int greedyRuns = cfg.greedyRuns > 0 ? cfg.greedyRuns : problem.dimension;
-        int eaRuns = cfg.eaRuns;
-        int saRuns = cfg.saRuns;
-
-        std::vector<double> randomScores;
-        std::vector<double> greedyScores;
-        std::vector<double> saScores;
-        std::vector<double> eaScores;
+        if (cfg.candidates != problem.candidates.k()) buildCandidateLists(problem, cfg.candidates);
+        InstanceJob job;
+        job.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        job.baseName = baseName;
+        job.vrpPath = vrpPath;
+        job.problem = std::move(problem);
+        job.optimalCost = readOptimalCost(optPath);
+        job.logDir = std::filesystem::path(cfg.logDir) / baseName;
+        std::filesystem::create_directories(job.logDir);
+        job.randomRuns = cfg.randomRuns;
+        job.greedyRuns = cfg.greedyRuns > 0 ? cfg.greedyRuns : job.problem.dimension;
+        job.saRuns = cfg.saRuns;
+        job.eaRuns = cfg.eaRuns;
+        job.randomScores.assign(job.randomRuns, 0.0);
+        job.greedyScores.assign(job.greedyRuns, 0.0);
+        job.saScores.assign(job.saRuns, 0.0);
+        job.eaScores.assign(job.eaRuns, 0.0);
+        job.randomMetrics.resize(job.randomRuns);
+        job.greedyMetrics.resize(job.greedyRuns);
+        job.saMetrics.resize(job.saRuns);
+        job.eaMetrics.resize(job.eaRuns);
+        jobs.push_back(std::move(job));
+    }
 
-        for (int run = 0; run < randomRuns; ++run) {
-            std::string logPath = (instLogDir / ("random_run_" + std::to_string(run) + ".csv")).string();
-            CSVLogger logger(logPath, "iteration,best,current,avg,worst");
-            Solution bestSol = runRandomSearch(problem, cfg.randomIterations, logger);
-            randomScores.push_back(bestSol.cost);
+    // Każdy run zapisuje wynik do własnego slotu, więc wyniki nie zależą od kolejności wykonania.
+    std::vector<RunTask> tasks;
+    for (auto& job : jobs) {
+        InstanceJob* jp = &job;
+        const double n = static_cast<double>(job.problem.dimension);
+        double saLevels = 0.0;
+        for (double t = cfg.saInitialTemp; t > cfg.saMinTemp && saLevels < 1e7; t *= cfg.saCoolingRate) saLevels += 1.0;
+        if (logs.aggregate) {
+            const int points = cfg.aggregatePoints;
+            long long saSteps = static_cast<long long>(saLevels) * cfg.saIterations + 1;
+            // Z automatycznym chłodzeniem długość runu SA wyznacza budżet ocen (budżet czasu: oszacowanie).
+            if (cfg.saAutoCooling && cfg.budgetEvaluations > 0) saSteps = cfg.budgetEvaluations;
+            job.randomCurves = std::make_unique<CurveAggregator>(job.randomRuns, curveStride(cfg.randomIterations, points));
+            job.greedyCurves = std::make_unique<CurveAggregator>(job.greedyRuns, curveStride(cfg.greedyRestarts, points));
+            job.saCurves = std::make_unique<CurveAggregator>(job.saRuns, curveStride(saSteps, points));
+            job.eaCurves = std::make_unique<CurveAggregator>(job.eaRuns, curveStride(cfg.eaGenerations, points));
         }
-
-        for (int run = 0; run < greedyRuns; ++run) {
-            std::string logPath = (instLogDir / ("greedy_run_" + std::to_string(run) + ".csv")).string();
-            CSVLogger logger(logPath, "restart,best,current,avg,worst");
-            Solution bestSol = runGreedy(problem, cfg.greedyRestarts, logger);
-            greedyScores.push_back(bestSol.cost);
+        for (int run = 0; run < job.randomRuns; ++run) {
+            tasks.push_back(RunTask{cfg.randomIterations * n, [jp, run, &cfg, &logs] {
+                jp->randomScores[run] = executeRun(cfg, logs, *jp, "random", "iteration,best,current,avg,worst", run,
+                                                   jp->randomCurves.get(), runRandomSearch, jp->randomMetrics[run]);
+            }});
         }
-
-        for (int run = 0; run < saRuns; ++run) {
-            std::string logPath = (instLogDir / ("sa_run_" + std::to_string(run) + ".csv")).string();
-            CSVLogger logger(logPath, "step,best,current,avg,worst");
-            Solution bestSol = runSimulatedAnnealing(problem, cfg, logger);
-            saScores.push_back(bestSol.cost);
+        for (int run = 0; run < job.greedyRuns; ++run) {
+            tasks.push_back(RunTask{cfg.greedyRestarts * n * n, [jp, run, &cfg, &logs] {
+                jp->greedyScores[run] = executeRun(cfg, logs, *jp, "greedy", "restart,best,current,avg,worst", run,
+                                                   jp->greedyCurves.get(), runGreedy, jp->greedyMetrics[run]);
+            }});
         }
-
-        for (int run = 0; run < eaRuns; ++run) {
-            std::string logPath = (instLogDir / ("ea_run_" + std::to_string(run) + ".csv")).string();
-            CSVLogger logger(logPath, "generation,best,avg,worst");
-            Solution bestSol = runEvolutionary(problem, cfg, logger);
-            eaScores.push_back(bestSol.cost);
+        for (int run = 0; run < job.saRuns; ++run) {
+            tasks.push_back(RunTask{saLevels * cfg.saIterations * n * std::max(1, cfg.saReplicas), [jp, run, &cfg, &logs] {
+                jp->saScores[run] = executeRun(cfg, logs, *jp, "sa", "step,best,current,avg,worst", run,
+                                               jp->saCurves.get(), runSimulatedAnnealing, jp->saMetrics[run]);
+            }});
+        }
+        for (int run = 0; run < job.eaRuns; ++run) {
+            tasks.push_back(RunTask{static_cast<double>(cfg.eaGenerations) * cfg.eaPopulation * n, [jp, run, &cfg, &logs] {
+                jp->eaScores[run] = executeRun(cfg, logs, *jp, "ea", kEaLogHeader, run,
+                                               jp->eaCurves.get(), runEvolutionary, jp->eaMetrics[run]);
+            }});
+        }
+    }
+    // Najdłuższe zadania najpierw (LPT); krótkie wypełniają luki na końcu dzięki podkradaniu.
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [](const RunTask& a, const RunTask& b) { return a.estimatedWork > b.estimatedWork; });
+    {
+        ThreadPool pool(cfg.threads);
+        for (auto& task : tasks) pool.submit(std::move(task.body));
+        try {
+            pool.wait();
+        } catch (const std::exception& ex) {
+            std::cerr << "Błąd podczas uruchomień: " << ex.what() << "\n";
+            return 1;
         }
+    }
 
-        RunStats randomStats = computeStats(randomScores);
-        RunStats greedyStats = computeStats(greedyScores);
-        RunStats saStats = computeStats(saScores);
-        RunStats eaStats = computeStats(eaScores);
+    for (const auto& job : jobs) {
+        RunStats randomStats = computeStats(job.randomScores);
+        RunStats greedyStats = computeStats(job.greedyScores);
+        RunStats saStats = computeStats(job.saScores);
+        RunStats eaStats = computeStats(job.eaScores);
 
-        std::cout << "Instancja: " << baseName << " (" << vrpPath << ")\n";
-        if (optimalCost > 0) {
-            std::cout << "Optymalny koszt (z pliku): " << optimalCost << "\n";
+        std::cout << "Instancja: " << job.baseName << " (" << job.vrpPath << ")\n";
+        if (job.optimalCost > 0) {
+            std::cout << "Optymalny koszt (z pliku): " << job.optimalCost << "\n";
         }
         auto printStats = [](const std::string& name, const RunStats& s) {
             std::cout << name << " -> best: " << s.best << ", worst: " << s.worst
@@ -108,14 +301,49 @@ int main(int argc, char** argv) {
         printStats("EA", eaStats);
         std::cout << "\n";
 
+        if (logs.aggregate) {
+            job.randomCurves->write((job.logDir / "random_curve.csv").string());
+            job.greedyCurves->write((job.logDir / "greedy_curve.csv").string());
+            job.saCurves->write((job.logDir / "sa_curve.csv").string());
+            job.eaCurves->write((job.logDir / "ea_curve.csv").string());
+        }
+
         std::ostringstream csvRow;
-        csvRow << baseName << "," << optimalCost << ","
-               << randomRuns << "," << randomStats.best << "," << randomStats.worst << "," << randomStats.avg << "," << randomStats.std << ","
-               << greedyRuns << "," << greedyStats.best << "," << greedyStats.worst << "," << greedyStats.avg << "," << greedyStats.std << ","
-               << eaRuns << "," << eaStats.best << "," << eaStats.worst << "," << eaStats.avg << "," << eaStats.std << ","
-               << saRuns << "," << saStats.best << "," << saStats.worst << "," << saStats.avg << "," << saStats.std;
+        csvRow << job.baseName << "," << job.optimalCost << ","
+               << job.randomRuns << "," << randomStats.best << "," << randomStats.worst << "," << randomStats.avg << "," << randomStats.std << ","
+               << job.greedyRuns << "," << greedyStats.best << "," << greedyStats.worst << "," << greedyStats.avg << "," << greedyStats.std << ","
+               << job.eaRuns << "," << eaStats.best << "," << eaStats.worst << "," << eaStats.avg << "," << eaStats.std << ","
+               << job.saRuns << "," << saStats.best << "," << saStats.worst << "," << saStats.avg << "," << saStats.std;
+        const std::vector<RunMetrics>* metrics[] = {&job.randomMetrics, &job.greedyMetrics, &job.eaMetrics,
+                                                    &job.saMetrics};
+        TimingSummary timings[4];
+        std::ostringstream timingRow;
+        timingRow << job.baseName;
+        for (int a = 0; a < 4; ++a) {
+            timings[a] = timingSummary(*metrics[a]);
+            timingRow << "," << timings[a].meanMs << "," << timings[a].evalsPerSecond;
+        }
+        for (const auto& timing : timings) {
+            csvRow << "," << timing.meanEvaluationsToBest;
+            timingRow << "," << timing.meanTimeToBestMs;
+        }
+        csvRow << "," << (job.problem.distances.onDemand() ? "on_demand" : "dense");
+        timingRow << "," << job.problem.parseMs << "," << job.loadMs;
         summaryCsv.push_back(csvRow.str());
+        timingCsv.push_back(timingRow.str());
 
+        const char* names[] = {"random", "greedy", "ea", "sa"};
+        const std::vector<double>* scores[] = {&job.randomScores, &job.greedyScores, &job.eaScores, &job.saScores};
+        for (int a = 0; a < 4; ++a) {
+            for (size_t run = 0; run < scores[a]->size(); ++run) {
+                const RunMetrics& m = (*metrics[a])[run];
+                std::ostringstream row;
+                row << job.baseName << "," << names[a] << "," << run << "," << (*scores[a])[run] << "," << m.wallMs
+                    << "," << m.evaluations << "," << m.timeToBestMs << "," << m.evaluationsToBest << ","
+                    << m.stopReason << "," << m.steps;
+                runsCsv.push_back(row.str());
+            }
+        }
     }
 
     std::ofstream csvFile(std::filesystem::path(cfg.logDir) / "summary.csv");
@@ -124,5 +352,13 @@ int main(int argc, char** argv) {
             csvFile << row << "\n";
         }
     }
+    std::ofstream timingFile(std::filesystem::path(cfg.logDir) / "summary_timing.csv");
+    if (timingFile.is_open()) {
+        for (const auto& row : timingCsv) timingFile << row << "\n";
+    }
+    std::ofstream runsFile(std::filesystem::path(cfg.logDir) / "runs.csv");
+    if (runsFile.is_open()) {
+        for (const auto& row : runsCsv) runsFile << row << "\n";
+    }
     return 0;
 }